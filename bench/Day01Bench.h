@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <execution>
+#include <filesystem>
+#include <fstream>
+#include <print>
+#include <random>
+#include <vector>
+
+#include "Day01.h"
+#include "Profiler.h"
+
+class Day01Bench {
+public:
+    Day01Bench() = delete; // This class is not meant to be instantiated
+    ~Day01Bench() = delete; // No inheritance either
+
+    static void run(size_t maxExponent);
+
+private:
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    [[nodiscard]] static std::vector<int64_t> randomList(size_t size);
+
+    [[nodiscard]] static size_t runsFor(size_t size) noexcept;
+
+    static void benchLoading(size_t maxExponent);
+
+    static void benchSorting(size_t maxExponent);
+
+    template<aoc::simd::SimdInteger T>
+    static void benchReductions(size_t maxExponent);
+
+    static void benchIncremental(size_t maxExponent);
+
+    static void benchSketch(size_t maxExponent);
+};
+
+inline void Day01Bench::run(const size_t maxExponent) {
+    benchLoading(maxExponent);
+    benchSorting(maxExponent);
+    benchReductions<int32_t>(maxExponent);
+    benchReductions<int64_t>(maxExponent);
+    benchIncremental(maxExponent);
+    benchSketch(maxExponent);
+}
+
+inline std::vector<int64_t> Day01Bench::randomList(const size_t size) {
+    // Same shape as the puzzle input: five digit location IDs
+    std::mt19937_64 rng{size};
+    std::uniform_int_distribution<int64_t> dist{10000, 99999};
+    std::vector<int64_t> list(size);
+    std::ranges::generate(list, [&] { return dist(rng); });
+    return list;
+}
+
+inline size_t Day01Bench::runsFor(const size_t size) noexcept {
+    return std::clamp(size_t{100'000'000} / size, size_t{1}, size_t{100});
+}
+
+inline void Day01Bench::benchLoading(const size_t maxExponent) {
+    std::println("Loading both lists (ms per load)");
+    std::println("{:>12} {:>14} {:>14} {:>14}", "elements", "stream parse", "fixed width", "binary cache");
+
+    const auto directory = std::filesystem::temp_directory_path();
+    const auto textPath = directory / "aoc-bench-lists.txt";
+    const auto cachePath = Day01::cachePathFor(textPath);
+    for (size_t exponent = 3, size = 1000; exponent <= std::min<size_t>(maxExponent, 8); ++exponent, size *= 10) {
+        const auto left = randomList(size);
+        auto right = randomList(size + 1);
+        right.resize(size);
+        {
+            std::ofstream out(textPath, std::ios::trunc);
+            for (size_t i = 0; i < size; ++i) {
+                out << left[i] << "   " << right[i] << '\n';
+            }
+        }
+        if (!Day01::writeListCache<int64_t>(cachePath, Day01::NumberLists(left, right), false)) {
+            std::println("Error writing list cache");
+            return;
+        }
+
+        volatile size_t sink{};
+        const auto runs = std::max<size_t>(runsFor(size) / 10, 1);
+        const auto stream = aoc::Profiler::profileWithSetup([] {
+        }, [&] {
+            auto file = Day01::openFile(textPath);
+            size_t pairs = 0;
+            (void) Day01::forEachPair<int64_t>(file.value(), [&](int64_t, int64_t)
+                -> std::expected<void, aoc::exceptions::AocException> {
+                    ++pairs;
+                    return {};
+                });
+            sink = pairs;
+        }, runs);
+        const auto text = aoc::Profiler::profileWithSetup([] {
+        }, [&] { sink = Day01::readLists<int64_t>(textPath)->size(); }, runs);
+        const auto cached = aoc::Profiler::profileWithSetup([] {
+        }, [&] { sink = Day01::readListCache<int64_t>(cachePath)->lists.size(); }, runs);
+
+        std::println("{:>12} {:>14.3f} {:>14.3f} {:>14.3f}", size, Milliseconds(stream).count(),
+                     Milliseconds(text).count(), Milliseconds(cached).count());
+    }
+    std::filesystem::remove(textPath);
+    std::filesystem::remove(cachePath);
+}
+
+inline void Day01Bench::benchSorting(const size_t maxExponent) {
+    std::println("Sorting (ms per sort, {} threads available)", tbb::this_task_arena::max_concurrency());
+    std::println("{:>12} {:>14} {:>14} {:>14} {:>14} {:>14}",
+                 "elements", "ranges::sort", "par_unseq", "radix", "parallel radix", "sortList");
+
+    for (size_t exponent = 3, size = 1000; exponent <= maxExponent; ++exponent, size *= 10) {
+        const auto input = randomList(size);
+        std::vector<int64_t> work;
+        const auto runs = runsFor(size);
+        const auto reset = [&] { work = input; };
+
+        const auto rangesSort = aoc::Profiler::profileWithSetup(reset, [&] { std::ranges::sort(work); }, runs);
+        const auto parallelStd = aoc::Profiler::profileWithSetup(reset, [&] {
+            std::sort(std::execution::par_unseq, work.begin(), work.end());
+        }, runs);
+        const auto radix = aoc::Profiler::profileWithSetup(reset, [&] {
+            aoc::sort::radixSort<int64_t>(work);
+        }, runs);
+        const auto parallelRadix = aoc::Profiler::profileWithSetup(reset, [&] {
+            aoc::sort::parallelRadixSort<int64_t>(work);
+        }, runs);
+        const auto dispatched = aoc::Profiler::profileWithSetup(reset, [&] { Day01::sortList(work); }, runs);
+
+        std::println("{:>12} {:>14.3f} {:>14.3f} {:>14.3f} {:>14.3f} {:>14.3f}", size,
+                     Milliseconds(rangesSort).count(), Milliseconds(parallelStd).count(),
+                     Milliseconds(radix).count(), Milliseconds(parallelRadix).count(),
+                     Milliseconds(dispatched).count());
+    }
+}
+
+template<aoc::simd::SimdInteger T>
+void Day01Bench::benchReductions(const size_t maxExponent) {
+    std::println("Reductions over int{} lists (GB/s of input read)", sizeof(T) * 8);
+    std::println("{:>12} {:>14} {:>14} {:>14} {:>14} {:>14}",
+                 "elements", "lambda absdiff", "simd absdiff", "par absdiff", "simd product", "par product");
+
+    for (size_t exponent = 3, size = 1000; exponent <= maxExponent; ++exponent, size *= 10) {
+        std::mt19937_64 rng{size};
+        std::uniform_int_distribution<T> dist{10000, 99999};
+        std::vector<T> left(size);
+        std::vector<T> right(size);
+        std::ranges::generate(left, [&] { return dist(rng); });
+        std::ranges::generate(right, [&] { return dist(rng); });
+
+        // Results go through a volatile sink so the reductions are not optimised away
+        volatile T sink{};
+        const auto runs = runsFor(size) * 10;
+        const auto gigabytesPerSecond = [size](const std::chrono::nanoseconds time) {
+            const auto seconds = std::chrono::duration<double>(time).count();
+            return static_cast<double>(2 * size * sizeof(T)) / 1e9 / std::max(seconds, 1e-12);
+        };
+        const auto measure = [&](auto &&reduce) {
+            return gigabytesPerSecond(aoc::Profiler::profileWithSetup([] {
+            }, [&] { sink = reduce(std::span<const T>{left}, std::span<const T>{right}); }, runs));
+        };
+
+        const auto lambda = measure([](auto a, auto b) {
+            return std::transform_reduce(a.begin(), a.end(), b.begin(), T{0}, std::plus(),
+                                         [](const T x, const T y) { return std::abs(x - y); });
+        });
+        const auto absDiff = measure(aoc::simd::sumAbsDiff<T>);
+        const auto parallelAbsDiff = measure(aoc::simd::parallelSumAbsDiff<T>);
+        const auto product = measure(aoc::simd::sumProducts<T>);
+        const auto parallelProduct = measure(aoc::simd::parallelSumProducts<T>);
+
+        std::println("{:>12} {:>14.2f} {:>14.2f} {:>14.2f} {:>14.2f} {:>14.2f}", size,
+                     lambda, absDiff, parallelAbsDiff, product, parallelProduct);
+    }
+}
+
+inline void Day01Bench::benchIncremental(const size_t maxExponent) {
+    std::println("Replacing one left and one right value (us per update)");
+    std::println("{:>12} {:>14} {:>14} {:>14}", "elements", "incremental", "alternating", "recompute");
+
+    // Recomputing sorts the whole input, so sizes stop well short of the sort benchmarks
+    for (size_t exponent = 3, size = 1000; exponent <= std::min<size_t>(maxExponent, 7); ++exponent, size *= 10) {
+        auto left = randomList(size);
+        auto right = randomList(size + 1);
+        right.resize(size);
+        auto incremental = Day01::IncrementalLists<int64_t>::fromLists(Day01::NumberLists(left, right));
+        if (!incremental) {
+            std::println("Error building incremental lists: {}", incremental.error().what());
+            return;
+        }
+
+        std::mt19937_64 rng{exponent};
+        std::uniform_int_distribution<int64_t> dist{10000, 99999};
+        volatile int64_t sink{};
+        const auto replace = [&](std::vector<int64_t> &list, auto &&erase, auto &&insert) {
+            const size_t index = rng() % list.size();
+            const int64_t value = dist(rng);
+            (void) erase(list[index]);
+            (void) insert(value);
+            list[index] = value;
+        };
+
+        const auto incrementalTime = aoc::Profiler::profileWithSetup([] {
+        }, [&] {
+            replace(left, [&](auto v) { return incremental->eraseLeft(v); },
+                    [&](auto v) { return incremental->insertLeft(v); });
+            replace(right, [&](auto v) { return incremental->eraseRight(v); },
+                    [&](auto v) { return incremental->insertRight(v); });
+            sink = incremental->distance() + incremental->similarity();
+        }, 1000);
+
+        // Worst case for the imbalance: sparse values alternating left, right, left, ... so that toggling
+        // a left value below all others flips every later imbalance between 0 and 1
+        std::vector<int64_t> evens(size);
+        std::vector<int64_t> odds(size);
+        for (size_t i = 0; i < size; ++i) {
+            evens[i] = static_cast<int64_t>(2 * i + 2) << 20;
+            odds[i] = static_cast<int64_t>(2 * i + 3) << 20;
+        }
+        auto alternating = Day01::IncrementalLists<int64_t>::fromLists(Day01::NumberLists(evens, odds));
+        if (!alternating) {
+            std::println("Error building incremental lists: {}", alternating.error().what());
+            return;
+        }
+        bool present = false;
+        const auto alternatingTime = aoc::Profiler::profileWithSetup([] {
+        }, [&] {
+            (void) (present ? alternating->eraseLeft(0) : alternating->insertLeft(0));
+            present = !present;
+            sink = alternating->distance();
+        }, 1000);
+
+        const auto noop = [](auto) { return true; };
+        const auto recomputeTime = aoc::Profiler::profileWithSetup([] {
+        }, [&] {
+            replace(left, noop, noop);
+            replace(right, noop, noop);
+            auto sortedLeft = left;
+            auto sortedRight = right;
+            Day01::sortList(sortedLeft);
+            Day01::sortList(sortedRight);
+            const auto results = Day01::calculateWithLists<int64_t>(sortedLeft, sortedRight);
+            sink = results.distance + results.similarity;
+        }, std::max<size_t>(runsFor(size) / 100, 3));
+
+        std::println("{:>12} {:>14.3f} {:>14.3f} {:>14.3f}", size,
+                     std::chrono::duration<double, std::micro>(incrementalTime).count(),
+                     std::chrono::duration<double, std::micro>(alternatingTime).count(),
+                     std::chrono::duration<double, std::micro>(recomputeTime).count());
+    }
+}
+
+inline void Day01Bench::benchSketch(const size_t maxExponent) {
+    std::println("Similarity score: exact sort + merge-join vs sketch estimate");
+    std::println("{:>12} {:>12} {:>12} {:>12} {:>12} {:>12} {:>12}",
+                 "elements", "width", "exact ms", "sketch ms", "rel error", "rel bound", "sketch KiB");
+
+    for (size_t exponent = 3, size = 1000; exponent <= maxExponent; ++exponent, size *= 10) {
+        const auto left = randomList(size);
+        auto right = randomList(size + 1);
+        right.resize(size);
+        const auto runs = runsFor(size);
+
+        Day01::ListResults<int64_t> exact{};
+        std::vector<int64_t> sortedLeft;
+        std::vector<int64_t> sortedRight;
+        const auto exactTime = aoc::Profiler::profileWithSetup([&] {
+            sortedLeft = left;
+            sortedRight = right;
+        }, [&] {
+            Day01::sortList(sortedLeft);
+            Day01::sortList(sortedRight);
+            exact = Day01::calculateWithLists<int64_t>(sortedLeft, sortedRight);
+        }, runs);
+
+        for (const size_t width: {size_t{1} << 10, size_t{1} << 16}) {
+            const Day01::SketchConfig config{width, Day01::DEFAULT_SKETCH_DEPTH};
+            std::expected<Day01::SimilarityEstimate<int64_t>, aoc::exceptions::AocException> estimate;
+            const auto sketchTime = aoc::Profiler::profileWithSetup([] {
+            }, [&] {
+                estimate = Day01::estimateSimilarity<int64_t>(std::span<const int64_t>{left},
+                                                              std::span<const int64_t>{right}, config);
+            }, runs);
+            if (!estimate) {
+                std::println("Error estimating similarity: {}", estimate.error().what());
+                return;
+            }
+
+            const auto relative = [&](const int64_t value) {
+                return static_cast<double>(value) / static_cast<double>(std::max<int64_t>(exact.similarity, 1));
+            };
+            std::println("{:>12} {:>12} {:>12.3f} {:>12.3f} {:>12.4f} {:>12.2f} {:>12}", size, width,
+                         Milliseconds(exactTime).count(), Milliseconds(sketchTime).count(),
+                         relative(estimate->estimate - exact.similarity), relative(estimate->errorBound),
+                         Day01::SimilaritySketch<int64_t>(config).memoryBytes() / 1024);
+        }
+    }
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <print>
+#include <random>
+#include <string_view>
+
+#include "Day02.h"
+#include "Profiler.h"
+
+class Day02Bench {
+public:
+    Day02Bench() = delete; // This class is not meant to be instantiated
+    ~Day02Bench() = delete; // No inheritance either
+
+    static void run(size_t maxExponent);
+
+private:
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    // Mostly safe reports with an occasional bad step, shaped like the puzzle input
+    [[nodiscard]] static aoc::FlatLists<int64_t> randomReports(size_t reports, size_t levels);
+
+    static void benchSafety(size_t maxExponent);
+
+    static void benchTolerance(size_t maxExponent);
+
+    static void benchRemovalBudget(size_t maxExponent);
+
+    static void benchStreaming(size_t maxExponent);
+
+    template<size_t K>
+    static void benchRemovalBudget(const aoc::FlatLists<int64_t> &reports, std::string_view name, bool bruteForce);
+};
+
+inline void Day02Bench::run(const size_t maxExponent) {
+    benchSafety(maxExponent);
+    benchTolerance(maxExponent);
+    benchRemovalBudget(maxExponent);
+    benchStreaming(maxExponent);
+}
+
+inline aoc::FlatLists<int64_t> Day02Bench::randomReports(const size_t reports, const size_t levels) {
+    std::mt19937_64 rng{reports * 31 + levels};
+    std::uniform_int_distribution<int64_t> step{1, 3};
+    std::uniform_int_distribution<size_t> badChance{0, levels * 2};
+    aoc::FlatLists<int64_t> lists;
+    lists.reserve(reports * levels, reports);
+    for (size_t report = 0; report < reports; ++report) {
+        const int64_t direction = rng() % 2 == 0 ? 1 : -1;
+        int64_t value = 50;
+        for (size_t level = 0; level < levels; ++level) {
+            value += badChance(rng) == 0 ? -direction * step(rng) : direction * step(rng);
+            lists.push(value);
+        }
+        lists.endRow();
+    }
+    return lists;
+}
+
+inline void Day02Bench::benchSafety(const size_t maxExponent) {
+    std::println("Safe reports (million reports per second)");
+    std::println("{:>12} {:>14} {:>14} {:>14}", "reports", "scalar loop", "parallel", "batched");
+
+    for (size_t exponent = 3, size = 1000; exponent <= std::min<size_t>(maxExponent, 7); ++exponent, size *= 10) {
+        const auto reports = randomReports(size, 8);
+        volatile size_t sink{};
+        const auto measure = [&](auto &&count) {
+            const auto time = aoc::Profiler::profileWithSetup([] {
+            }, [&] { sink = count(); }, std::max<size_t>(10'000'000 / size, 3));
+            return static_cast<double>(size) / 1e6 / std::max(std::chrono::duration<double>(time).count(), 1e-12);
+        };
+
+        const auto scalar = measure([&] {
+            size_t safe = 0;
+            for (const auto report: reports) {
+                if (Day02::isSafe<int64_t>(report)) safe++;
+            }
+            return safe;
+        });
+        const auto parallel = measure([&] { return Day02::countSafeParallel(reports, Day02::isSafe<int64_t>); });
+        const auto batched = measure([&] { return Day02::countSafeParallel(reports, Day02::BatchedSafe<>{}); });
+        std::println("{:>12} {:>14.2f} {:>14.2f} {:>14.2f}", size, scalar, parallel, batched);
+    }
+}
+
+inline void Day02Bench::benchTolerance(const size_t maxExponent) {
+    // Total work is held constant, so the columns show how each check scales with report length
+    const size_t totalLevels = std::min<size_t>(1'000'000, static_cast<size_t>(std::pow(10.0, maxExponent)));
+    std::println("Safe with one removal (ms per input of {} levels)", totalLevels);
+    std::println("{:>12} {:>14} {:>14} {:>14}", "levels", "brute force", "smart", "linear");
+    for (const size_t levels: {5, 8, 64, 512}) {
+        const auto reports = randomReports(std::max<size_t>(totalLevels / levels, 1), levels);
+        volatile size_t sink{};
+        const auto measure = [&](auto &&check) {
+            return Milliseconds(aoc::Profiler::profileWithSetup([] {
+            }, [&] { sink = Day02::countSafeParallel(reports, check); }, 5)).count();
+        };
+
+        const auto bruteForce = measure(Day02::isSafeWithChance<int64_t>);
+        const auto smart = measure(Day02::canBeMadeSafe<int64_t>);
+        const auto linear = measure(Day02::canBeMadeSafeLinear<int64_t>);
+        std::println("{:>12} {:>14.3f} {:>14.3f} {:>14.3f}", levels, bruteForce, smart, linear);
+    }
+}
+
+inline void Day02Bench::benchRemovalBudget(const size_t maxExponent) {
+    std::println("Safe with up to k removals (ms per input)");
+    std::println("{:>28} {:>4} {:>10} {:>14} {:>14} {:>14}", "input", "k", "safe", "brute force", "runtime k",
+                 "compile-time k");
+
+    // Long reports: brute force is only run where it finishes in reasonable time
+    if (const auto file = Day02::readLists<int64_t>(std::filesystem::path{"../data"} / "d2p2-custom-large-test.txt");
+        file) {
+        benchRemovalBudget<1>(*file, "d2p2-custom-large-test.txt", true);
+        benchRemovalBudget<2>(*file, "d2p2-custom-large-test.txt", true);
+        benchRemovalBudget<3>(*file, "d2p2-custom-large-test.txt", false);
+        benchRemovalBudget<8>(*file, "d2p2-custom-large-test.txt", false);
+    } else {
+        std::println("Skipping d2p2-custom-large-test.txt: {}", file.error().what());
+    }
+
+    const size_t reports = std::min<size_t>(100'000, static_cast<size_t>(std::pow(10.0, maxExponent)));
+    const auto generated = randomReports(reports, 8);
+    benchRemovalBudget<1>(generated, "generated, 8 levels", true);
+    benchRemovalBudget<2>(generated, "generated, 8 levels", true);
+    benchRemovalBudget<3>(generated, "generated, 8 levels", true);
+}
+
+template<size_t K>
+void Day02Bench::benchRemovalBudget(const aoc::FlatLists<int64_t> &reports, const std::string_view name,
+                                    const bool bruteForce) {
+    volatile size_t sink{};
+    size_t safe = 0;
+    const auto measure = [&](auto &&check) {
+        return Milliseconds(aoc::Profiler::profileWithSetup([] {
+        }, [&] { sink = safe = Day02::countSafeParallel(reports, check); }, 3)).count();
+    };
+
+    const auto brute = bruteForce
+                           ? measure([](std::span<const int64_t> list) {
+                               return Day02::isSafeWithChances<int64_t>(list, K);
+                           })
+                           : std::numeric_limits<double>::quiet_NaN();
+    const auto runtime = measure([](std::span<const int64_t> list) {
+        return Day02::canBeMadeSafeUpTo<int64_t>(list, K);
+    });
+    const auto compileTime = measure(Day02::canBeMadeSafeUpTo<int64_t, K>);
+    std::println("{:>28} {:>4} {:>10} {:>14.3f} {:>14.3f} {:>14.3f}", name, K, safe, brute, runtime, compileTime);
+}
+
+inline void Day02Bench::benchStreaming(const size_t maxExponent) {
+    std::println("Both counts from a report file (MB/s of text)");
+    std::println("{:>12} {:>12} {:>16} {:>16}", "reports", "MB", "parse + check", "streaming");
+
+    const auto path = std::filesystem::temp_directory_path() / "aoc-bench-reports.txt";
+    for (size_t exponent = 3, size = 1000; exponent <= std::min<size_t>(maxExponent, 7); ++exponent, size *= 10) {
+        {
+            std::ofstream out(path, std::ios::trunc);
+            for (const auto report: randomReports(size, 8)) {
+                for (size_t i = 0; i < report.size(); ++i) {
+                    out << report[i] << (i + 1 < report.size() ? ' ' : '\n');
+                }
+            }
+        }
+        const auto megabytes = static_cast<double>(std::filesystem::file_size(path)) / 1e6;
+
+        volatile size_t sink{};
+        const auto runs = std::max<size_t>(1'000'000 / size, 3);
+        const auto throughput = [&](auto &&count) {
+            const auto time = aoc::Profiler::profileWithSetup([] {
+            }, [&] { sink = count(); }, runs);
+            return megabytes / std::max(std::chrono::duration<double>(time).count(), 1e-12);
+        };
+
+        const auto parsed = throughput([&] {
+            const auto lists = Day02::readLists<int64_t>(path);
+            return Day02::countSafeParallel(*lists, Day02::BatchedSafe<>{}) +
+                   Day02::countSafeParallel(*lists, Day02::canBeMadeSafeLinear<int64_t>);
+        });
+        const auto streamed = throughput([&] {
+            auto stream = Day02::openFile(path);
+            const auto counts = Day02::scanReports<int64_t>(stream.value());
+            return counts->safe + counts->safeWithOneRemoval;
+        });
+        std::println("{:>12} {:>12.2f} {:>16.1f} {:>16.1f}", size, megabytes, parsed, streamed);
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <print>
+#include <random>
+#include <string>
+
+#include "Day03.h"
+#include "Profiler.h"
+
+class Day03Bench {
+public:
+    Day03Bench() = delete; // This class is not meant to be instantiated
+    ~Day03Bench() = delete; // No inheritance either
+
+    static void run(size_t maxExponent);
+
+private:
+    // Instructions, near misses and noise in roughly the puzzle input's proportions
+    [[nodiscard]] static std::string randomMemory(size_t bytes);
+
+    static void benchScanning(size_t maxExponent);
+
+    static void benchTokenStream(size_t maxExponent);
+
+    // Beyond this the regex paths take too long to be worth timing
+    static constexpr size_t REGEX_LIMIT = 1'000'000;
+};
+
+inline void Day03Bench::run(const size_t maxExponent) {
+    benchScanning(maxExponent);
+    benchTokenStream(maxExponent);
+}
+
+inline std::string Day03Bench::randomMemory(const size_t bytes) {
+    static constexpr std::string_view NOISE = "()[]{},;:'!@#$%^&*<>?/+-~ whenwhoselectfromhow";
+    std::mt19937_64 rng{bytes};
+    std::uniform_int_distribution<size_t> kind{0, 99};
+    std::uniform_int_distribution<int> operand{0, 999};
+    std::uniform_int_distribution<size_t> noise{0, NOISE.size() - 1};
+    std::string memory;
+    memory.reserve(bytes + 16);
+    while (memory.size() < bytes) {
+        const size_t k = kind(rng);
+        if (k < 8) {
+            memory += std::format("mul({},{})", operand(rng), operand(rng));
+        } else if (k < 10) {
+            memory += std::format("mul({},{}]", operand(rng), operand(rng));
+        } else if (k == 10) {
+            memory += "do()";
+        } else if (k == 11) {
+            memory += "don't()";
+        } else {
+            memory += NOISE[noise(rng)];
+        }
+    }
+    return memory;
+}
+
+inline void Day03Bench::benchScanning(const size_t maxExponent) {
+    std::println("Sum of multiplications (MB/s)");
+    std::println("{:>12} {:>14} {:>14} {:>14} {:>14} {:>14} {:>14}", "bytes", "regex", "scanner", "regex do",
+                 "scanner do", "parallel both", "streamed both");
+
+    for (size_t exponent = 4, size = 10'000; exponent <= std::min<size_t>(maxExponent, 9); ++exponent, size *= 10) {
+        const std::string memory = randomMemory(size);
+        volatile int64_t sink{};
+        const auto throughput = [&](auto &&sum) {
+            const auto time = aoc::Profiler::profileWithSetup([] {
+            }, [&] { sink = sum(); }, std::max<size_t>(100'000'000 / size, 3));
+            return static_cast<double>(size) / 1e6 / std::max(std::chrono::duration<double>(time).count(), 1e-12);
+        };
+        const bool regex = size <= REGEX_LIMIT;
+        constexpr double SKIPPED = std::numeric_limits<double>::quiet_NaN();
+
+        const auto regexAll = regex
+                                  ? throughput([&] { return Day03::processMultiplicationsRegex<int64_t>(memory); })
+                                  : SKIPPED;
+        const auto scannerAll = throughput([&] { return Day03::processMultiplications<int64_t>(memory); });
+        const auto regexEnabled = regex
+                                      ? throughput([&] { return Day03::sumMultiplicationsDDRegex<int64_t>(memory); })
+                                      : SKIPPED;
+        const auto scannerEnabled = throughput([&] { return Day03::sumMultiplicationsDD<int64_t>(memory); });
+        const auto parallel = throughput([&] {
+            const auto summary = Day03::scanParallel<int64_t>(memory);
+            return summary.all + summary.whenEnabled;
+        });
+        // Blocks the size partOne and partTwo read from the file
+        const auto streamed = throughput([&] {
+            Day03::StreamingSum<int64_t> engine;
+            for (size_t i = 0; i < memory.size(); i += Day03::STREAM_BLOCK_SIZE) {
+                engine.feed(std::string_view{memory}.substr(i, Day03::STREAM_BLOCK_SIZE));
+            }
+            return engine.sum() + engine.enabledSum();
+        });
+        std::println("{:>12} {:>14.1f} {:>14.1f} {:>14.1f} {:>14.1f} {:>14.1f} {:>14.1f}", size, regexAll,
+                     scannerAll, regexEnabled, scannerEnabled, parallel, streamed);
+    }
+}
+
+inline void Day03Bench::benchTokenStream(const size_t maxExponent) {
+    std::println("Three queries: rescanning the text vs one token stream (ms)");
+    std::println("{:>12} {:>10} {:>14} {:>14} {:>14} {:>14} {:>14}", "bytes", "tokens", "rescan x3", "tokenize",
+                 "sum all", "sum enabled", "sections");
+
+    for (size_t exponent = 4, size = 10'000; exponent <= std::min<size_t>(maxExponent, 8); ++exponent, size *= 10) {
+        const std::string memory = randomMemory(size);
+        const auto tokens = Day03::tokenize(memory);
+        volatile int64_t sink{};
+        const auto milliseconds = [&](auto &&query) {
+            const auto time = aoc::Profiler::profileWithSetup([] {
+            }, [&] { sink = static_cast<int64_t>(query()); }, std::max<size_t>(100'000'000 / size, 3));
+            return std::chrono::duration<double, std::milli>(time).count();
+        };
+
+        const auto rescan = milliseconds([&] {
+            const auto sections = Day03::sections(Day03::tokenize(memory)).size(); // Needs the offsets anyway
+            return Day03::processMultiplications<int64_t>(memory) + Day03::sumMultiplicationsDD<int64_t>(memory) +
+                   static_cast<int64_t>(sections);
+        });
+        const auto tokenize = milliseconds([&] { return Day03::tokenize(memory).size(); });
+        const auto all = milliseconds([&] { return Day03::sumAll<int64_t>(tokens); });
+        const auto enabled = milliseconds([&] { return Day03::sumEnabled<int64_t>(tokens); });
+        const auto sections = milliseconds([&] { return Day03::sections(tokens).size(); });
+        std::println("{:>12} {:>10} {:>14.3f} {:>14.3f} {:>14.3f} {:>14.3f} {:>14.3f}", size, tokens.size(), rescan,
+                     tokenize, all, enabled, sections);
+    }
+}
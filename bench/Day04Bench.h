@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Day04.h"
+#include "Profiler.h"
+
+class Day04Bench {
+public:
+    Day04Bench() = delete; // This class is not meant to be instantiated
+    ~Day04Bench() = delete; // No inheritance either
+
+    static void run(size_t maxExponent);
+
+private:
+    // Square grid of XMAS letters and noise, roughly as dense in matches as the puzzle input
+    [[nodiscard]] static std::vector<char> randomGrid(size_t side);
+
+    static void benchCounting(size_t maxExponent);
+
+    static void benchDictionary(size_t maxExponent);
+
+    // Beyond this many cells the position list of findAll takes too long to be worth timing
+    static constexpr size_t FIND_ALL_LIMIT = 25'000'000;
+
+    // Beyond this many cells the X and A position lists (8 bytes per entry) would outgrow the grids
+    // themselves, so the columns that take them are skipped
+    static constexpr size_t POSITION_LIMIT = 1'000'000'000;
+
+    // Beyond this many words one grid pass per word takes too long to be worth timing
+    static constexpr size_t RESCAN_LIMIT = 100;
+};
+
+inline void Day04Bench::run(const size_t maxExponent) {
+    benchCounting(maxExponent);
+    benchDictionary(maxExponent);
+}
+
+inline std::vector<char> Day04Bench::randomGrid(const size_t side) {
+    std::mt19937_64 rng{side};
+    std::uniform_int_distribution<size_t> letter{0, 3};
+    std::vector<char> data(side * side);
+    std::ranges::generate(data, [&] { return "XMAS"[letter(rng)]; });
+    return data;
+}
+
+inline void Day04Bench::benchCounting(const size_t maxExponent) {
+    std::println("Counting XMAS and X-MAS (million cells per second)");
+    std::println("{:>12} {:>14} {:>14} {:>14} {:>14} {:>14} {:>14} {:>14} {:>14} {:>14}", "cells", "findAll",
+                 "count only", "packed", "tiled", "bitboard", "patterns", "tiled x", "bitboard x", "to bitboard");
+
+    // Sides for about 10^4 .. 10^9 cells, then the 50k puzzle-scale grid; a side runs when its cell
+    // count has at most maxExponent digits past the first. 50k^2 holds the grid three times over
+    // (chars, padded, bit planes), about 6.5 GB, so it only runs with maxExponent >= 9
+    for (const size_t side: std::to_array<size_t>({140, 1'000, 3'163, 10'000, 31'623, 50'000})) {
+        const size_t cells = side * side;
+        if (static_cast<size_t>(std::log10(static_cast<double>(cells))) > maxExponent) break;
+
+        const auto data = randomGrid(side);
+        const bool positions = cells <= POSITION_LIMIT;
+        std::vector<size_t> xPositions;
+        std::vector<size_t> aPositions;
+        for (size_t i = 0; positions && i < data.size(); ++i) {
+            if (data[i] == 'X') xPositions.push_back(i);
+            if (data[i] == 'A') aPositions.push_back(i);
+        }
+        const auto grid = Day04::toBitGrid(data, side, side);
+        const auto padded = Day04::toPaddedGrid(data, side, side);
+
+        volatile size_t sink{};
+        const auto rate = [&](auto &&count) {
+            const auto time = aoc::Profiler::profileWithSetup([] {
+            }, [&] { sink = count(); }, std::max<size_t>(10'000'000 / cells, 3));
+            return static_cast<double>(cells) / 1e6 / std::max(std::chrono::duration<double>(time).count(), 1e-12);
+        };
+        constexpr double SKIPPED = std::numeric_limits<double>::quiet_NaN();
+
+        const auto findAll = cells <= FIND_ALL_LIMIT
+                                 ? rate([&] { return Day04::findAll(data, xPositions, side, side).size(); })
+                                 : SKIPPED;
+        const auto countOnly = positions ? rate([&] { return Day04::countAll(padded, xPositions); }) : SKIPPED;
+        // Packed indices stop at PACKED_CELL_LIMIT cells, past that findAllPacked only reports an error
+        const auto packed = positions && cells <= Day04::PACKED_CELL_LIMIT
+                                ? rate([&] {
+                                    const auto matches = Day04::findAllPacked(padded, xPositions);
+                                    return matches.has_value() ? matches->size() : size_t{0};
+                                })
+                                : SKIPPED;
+        const auto tiled = rate([&] { return Day04::countWordsTiled(padded); });
+        const auto words = rate([&] { return Day04::countWordsBitboard(grid); });
+        const auto patterns = positions
+                                  ? rate([&] { return Day04::countPatterns(data, side, side, aPositions); })
+                                  : SKIPPED;
+        const auto tiledCrosses = rate([&] { return Day04::countCrossesTiled(padded); });
+        const auto crosses = rate([&] { return Day04::countCrossesBitboard(grid); });
+        const auto convert = rate([&] { return Day04::toBitGrid(data, side, side).wordsPerRow; });
+        std::println("{:>12} {:>14.1f} {:>14.1f} {:>14.1f} {:>14.1f} {:>14.1f} {:>14.1f} {:>14.1f} {:>14.1f} {:>14.1f}",
+                     cells, findAll, countOnly, packed, tiled, words, patterns, tiledCrosses, crosses, convert);
+    }
+}
+
+inline void Day04Bench::benchDictionary(const size_t maxExponent) {
+    const size_t side = maxExponent >= 6 ? 1'000 : 140;
+    std::println("Dictionary search on a {}x{} grid, one pass per word vs one automaton (ms)", side, side);
+    std::println("{:>12} {:>14} {:>14} {:>14} {:>14}", "words", "states", "matches", "per word", "automaton");
+
+    const auto data = randomGrid(side);
+    std::mt19937_64 rng{side};
+    std::uniform_int_distribution<size_t> letter{0, 3};
+    std::uniform_int_distribution<size_t> length{6, 12}; // Short words would match nearly everywhere
+    for (size_t count = 1; count <= 10'000; count *= 10) {
+        std::vector<std::string> storage(count);
+        for (auto &word: storage) {
+            word.resize(length(rng));
+            std::ranges::generate(word, [&] { return "XMAS"[letter(rng)]; });
+        }
+        const std::vector<std::string_view> words(storage.begin(), storage.end());
+
+        volatile size_t sink{};
+        const auto milliseconds = [&](auto &&search) {
+            const auto time = aoc::Profiler::profileWithSetup([] {
+            }, [&] { sink = search(); }, 3);
+            return std::chrono::duration<double, std::milli>(time).count();
+        };
+        constexpr double SKIPPED = std::numeric_limits<double>::quiet_NaN();
+
+        size_t matches = 0;
+        const auto found = Day04::findWords(data, side, side, words);
+        for (const auto &positions: *found) {
+            matches += positions.size();
+        }
+        const auto perWord = count <= RESCAN_LIMIT
+                                 ? milliseconds([&] {
+                                     size_t total = 0;
+                                     for (const auto word: words) {
+                                         total += Day04::findWords(data, side, side, std::array{word})->front().size();
+                                     }
+                                     return total;
+                                 })
+                                 : SKIPPED;
+        const auto automaton = milliseconds([&] { return Day04::findWords(data, side, side, words)->size(); });
+        std::println("{:>12} {:>14} {:>14} {:>14.1f} {:>14.1f}", count,
+                     aoc::AhoCorasick::build(words)->stateCount(), matches, perWord, automaton);
+    }
+}
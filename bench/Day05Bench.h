@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <print>
+#include <random>
+#include <regex>
+#include <string>
+
+#include "Day05.h"
+#include "Profiler.h"
+
+class Day05Bench {
+public:
+    Day05Bench() = delete; // This class is not meant to be instantiated
+    ~Day05Bench() = delete; // No inheritance either
+
+    static void run(size_t maxExponent);
+
+private:
+    static void benchRuleParsing(size_t maxExponent);
+
+    // Same result as Day05::readRules, one std::regex_match per line
+    [[nodiscard]] static size_t readRulesRegex(const std::filesystem::path &path);
+};
+
+inline void Day05Bench::run(const size_t maxExponent) {
+    benchRuleParsing(maxExponent);
+}
+
+inline size_t Day05Bench::readRulesRegex(const std::filesystem::path &path) {
+    static const std::regex rulePattern(R"((\d+)\|(\d+))", std::regex::optimize);
+    std::ifstream file(path);
+    std::string line;
+    std::smatch match;
+    size_t checksum = 0;
+    while (std::getline(file, line)) {
+        if (std::regex_match(line, match, rulePattern)) {
+            checksum += static_cast<size_t>(std::stoi(match[1].str()) + std::stoi(match[2].str()));
+        }
+    }
+    return checksum;
+}
+
+inline void Day05Bench::benchRuleParsing(const size_t maxExponent) {
+    std::println("Reading \"a|b\" rules (million lines per second)");
+    std::println("{:>12} {:>14} {:>14} {:>14}", "lines", "std::regex", "split", "pattern");
+
+    const auto path = std::filesystem::temp_directory_path() / "aoc-bench-rules.txt";
+    for (size_t exponent = 3, size = 1000; exponent <= std::min<size_t>(maxExponent, 7); ++exponent, size *= 10) {
+        {
+            std::mt19937_64 rng{size};
+            std::uniform_int_distribution<int> page{10, 99};
+            std::ofstream out(path, std::ios::trunc);
+            for (size_t i = 0; i < size; ++i) {
+                out << page(rng) << '|' << page(rng) << '\n';
+            }
+        }
+
+        volatile size_t sink{};
+        const auto rate = [&](auto &&parse) {
+            const auto time = aoc::Profiler::profileWithSetup([] {
+            }, [&] { sink = parse(); }, std::max<size_t>(1'000'000 / size, 3));
+            return static_cast<double>(size) / 1e6 / std::max(std::chrono::duration<double>(time).count(), 1e-12);
+        };
+
+        const auto regex = rate([&] { return readRulesRegex(path); });
+        const auto split = rate([&] { return Day05::readLists<int>(path, '|')->size(); });
+        const auto pattern = rate([&] { return Day05::readRules<int>(path)->size(); });
+        std::println("{:>12} {:>14.2f} {:>14.2f} {:>14.2f}", size, regex, split, pattern);
+    }
+    std::filesystem::remove(path);
+}
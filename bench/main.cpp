@@ -0,0 +1,34 @@
+#include <charconv>
+#include <print>
+#include <string_view>
+
+#include "Day01Bench.h"
+#include "Day02Bench.h"
+#include "Day03Bench.h"
+#include "Day04Bench.h"
+#include "Day05Bench.h"
+
+int main(const int argc, char *argv[]) {
+    // Largest input size as a power of ten, pass a smaller one on machines without tens of GB of RAM
+    size_t maxExponent = 9;
+    if (argc > 1) {
+        const std::string_view arg{argv[1]};
+        if (const auto [p, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), maxExponent);
+            ec != std::errc{}) {
+            std::println("Usage: {} [max size exponent]", argv[0]);
+            return 1;
+        }
+    }
+
+    std::println("Day 1:");
+    Day01Bench::run(maxExponent);
+    std::println("Day 2:");
+    Day02Bench::run(maxExponent);
+    std::println("Day 3:");
+    Day03Bench::run(maxExponent);
+    std::println("Day 4:");
+    Day04Bench::run(maxExponent);
+    std::println("Day 5:");
+    Day05Bench::run(maxExponent);
+    return 0;
+}
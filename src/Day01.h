@@ -1,15 +1,31 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
 #include <expected>
 #include <filesystem>
 #include <fstream>
+#include <limits>
 #include <numeric>
+#include <optional>
 #include <print>
+#include <spanstream>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "AocExceptions.h"
 #include "AocTemplates.h"
+#include "CountMinSketch.h"
+#include "ExternalSort.h"
+#include "MappedFile.h"
+#include "RadixSort.h"
+#include "Simd.h"
+#include "SwarDigits.h"
 
 class Day01 {
 public:
@@ -26,22 +42,284 @@ public:
         [[nodiscard]] size_t size() const noexcept;
     };
 
+    template<aoc::templates::Numeric T>
+    struct ListResults {  // Both answers from a single pass
+        T distance;
+        T similarity;
+    };
+
+    template<std::integral T>
+    struct SimilarityEstimate {  // Approximate similarity score from fixed size sketches
+        T estimate; // Never below the exact score
+        T errorBound; // estimate - exact <= errorBound with probability confidence
+        double confidence;
+    };
+
+    // Keeps both answers current while single values are added to or removed from either list.
+    // distance() equals the sorted pair distance whenever both lists hold the same number of values.
+    //
+    // Both lists live in one sorted sequence of entries, +1 for a left value and -1 for a right one,
+    // cut into blocks of about sqrt(n) entries. The distance is the sum over gaps between neighbouring
+    // entries of gap * |imbalance|, imbalance being the running sum of the entries before the gap. Each
+    // block keeps the gap weight per imbalance level relative to its start, summed from the top level
+    // down, so an insert or erase rebuilds its own block in O(sqrt n) and shifts every later block by
+    // one level in O(1) each: O(sqrt n) per update in the worst case, whatever the values or their order.
+    // Memory is linear in the number of values, not in their range.
+    template<std::integral T>
+    class IncrementalLists {
+    public:
+        static std::expected<IncrementalLists, aoc::exceptions::AocException> create() noexcept;
+
+        static std::expected<IncrementalLists, aoc::exceptions::AocException> fromLists(
+            const NumberLists<T> &lists) noexcept;
+
+        std::expected<void, aoc::exceptions::AocException> insertLeft(T value) noexcept;
+
+        std::expected<void, aoc::exceptions::AocException> eraseLeft(T value) noexcept;
+
+        std::expected<void, aoc::exceptions::AocException> insertRight(T value) noexcept;
+
+        std::expected<void, aoc::exceptions::AocException> eraseRight(T value) noexcept;
+
+        [[nodiscard]] T distance() const noexcept;
+
+        [[nodiscard]] T similarity() const noexcept;
+
+        [[nodiscard]] size_t leftSize() const noexcept;
+
+        [[nodiscard]] size_t rightSize() const noexcept;
+
+        // rank-th smallest value (0-based) of each list
+        [[nodiscard]] std::optional<T> nthLeft(size_t rank) const noexcept;
+
+        [[nodiscard]] std::optional<T> nthRight(size_t rank) const noexcept;
+
+    private:
+        static constexpr size_t MIN_BLOCK = 32;
+
+        struct Entry {
+            T value;
+            int64_t step; // +1 left, -1 right
+
+            constexpr bool operator==(const Entry &other) const noexcept = default;
+
+            // Lefts before rights among equal values; the gap between them is zero either way
+            constexpr auto operator<=>(const Entry &other) const noexcept {
+                return std::pair{value, -step} <=> std::pair{other.value, -other.step};
+            }
+        };
+
+        struct Block {
+            std::vector<Entry> entries;
+            int64_t entryLevel = 0; // Imbalance before the first entry
+            size_t lefts = 0;
+            // atLeast[r + size] = gap weight after entries whose level relative to entryLevel is >= r
+            std::vector<int64_t> atLeast;
+            int64_t contribution = 0; // Sum of gap * |imbalance| over the block's gaps
+        };
+
+        IncrementalLists() = default;
+
+        std::expected<void, aoc::exceptions::AocException> update(Entry entry, bool insert) noexcept;
+
+        // Target block size for the current number of values
+        [[nodiscard]] size_t blockSize() const noexcept;
+
+        // First block whose last entry is not below entry, the last block if there is none
+        [[nodiscard]] size_t findBlock(const Entry &entry) const noexcept;
+
+        // Capacity for the level weights of a block holding entries values, so rebuild never allocates
+        static void reserveLevels(Block &block, size_t entries);
+
+        // Recomputes the level weights and contribution of one block from its entries and entryLevel
+        void rebuild(size_t index) noexcept;
+
+        // Moves a whole block one imbalance level up or down
+        void shift(Block &block, int64_t delta) noexcept;
+
+        // Weight of the block's gaps with relative level >= level
+        [[nodiscard]] static int64_t weightAtLeast(const Block &block, int64_t level) noexcept;
+
+        // Splits an oversized block, merges an undersized one into a neighbour. Allocates before changing
+        // anything, so a failure leaves valid blocks that are only out of balance.
+        void rebalance(size_t index);
+
+        [[nodiscard]] std::optional<T> nth(bool leftSide, size_t rank) const noexcept;
+
+        std::vector<Block> blocks;
+        std::unordered_map<T, std::pair<int64_t, int64_t> > counts; // Value -> (left count, right count)
+        size_t lefts = 0;
+        size_t rights = 0;
+        int64_t total = 0; // Sum of the block contributions
+        T similarityScore{0};
+    };
+
     static void partOne();
 
     static void partTwo();
 
+    static void bothParts();
+
+    // Keeps at most memoryBudget bytes of values in memory, everything else is spilled to sorted runs on disk
+    static void bothPartsExternal(size_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+
+    // Streams the input through two sketches of width * depth counters each, whatever its length
+    static void partTwoApproximate(size_t sketchWidth = DEFAULT_SKETCH_WIDTH,
+                                   size_t sketchDepth = DEFAULT_SKETCH_DEPTH);
+
 #ifdef TESTING
     friend class Day01Test;
 #endif
+#ifdef BENCHMARKING
+    friend class Day01Bench;
+#endif
 
 private:
+    struct ExternalSortConfig {
+        size_t memoryBudget; // Bytes of buffered values across both columns
+        std::filesystem::path tempDirectory; // Sorted runs are spilled below here
+    };
+
+    struct SketchConfig {
+        size_t width; // Counters per row, error shrinks as e / width
+        size_t depth; // Independent rows, failure probability shrinks as exp(-depth)
+    };
+
+    // Sketches of the value weighted left counts and of the right counts; the similarity score is exactly
+    // their inner product, which Count-Min overestimates by at most e / width * |left|_1 * |right|_1
+    template<std::integral T>
+    class SimilaritySketch {
+    public:
+        explicit SimilaritySketch(const SketchConfig &config);
+
+        std::expected<void, aoc::exceptions::AocException> add(T left, T right) noexcept;
+
+        [[nodiscard]] std::expected<SimilarityEstimate<T>, aoc::exceptions::AocException> result() const noexcept;
+
+        [[nodiscard]] size_t memoryBytes() const noexcept;
+
+    private:
+        aoc::CountMinSketch<int64_t> leftWeights;
+        aoc::CountMinSketch<int64_t> rightCounts;
+    };
+
+    // Binary cache layout: this header, then count left values, then count right values, native byte order
+    struct CacheHeader {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t elementTag; // Size and kind of T, also catches a cache written with the other byte order
+        uint64_t count;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    struct FixedLayout {  // One record of the puzzle input, e.g. "38450   56790\n"
+        size_t leftDigits;
+        size_t gap;
+        size_t rightDigits;
+        size_t lineEnd; // 1 for "\n", 2 for "\r\n"
+
+        [[nodiscard]] constexpr size_t recordSize() const noexcept { return leftDigits + gap + rightDigits + lineEnd; }
+    };
+
+    template<aoc::templates::Numeric T>
+    struct CachedLists {
+        NumberLists<T> lists;
+        bool sorted;
+    };
+
+    static constexpr std::array<char, 8> CACHE_MAGIC{'A', 'O', 'C', 'D', '0', '1', 'L', 'S'};
+    static constexpr uint32_t CACHE_VERSION = 1;
+    static constexpr uint32_t CACHE_SORTED = 1; // Both columns are sorted ascending
+
+    template<aoc::templates::Numeric T>
+    static constexpr uint32_t cacheElementTag() noexcept {
+        const uint32_t kind = std::is_floating_point_v<T> ? 2 : std::is_signed_v<T> ? 1 : 0;
+        return static_cast<uint32_t>(sizeof(T)) | kind << 8 | uint32_t{0xD1} << 24;
+    }
+
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = size_t{64} << 20;
+    static constexpr size_t DEFAULT_SKETCH_WIDTH = size_t{1} << 16;
+    static constexpr size_t DEFAULT_SKETCH_DEPTH = 5;
+    static constexpr size_t MIN_RUN_BUFFER = size_t{1} << 12; // Values buffered per run while merging, budget allowing
+    static constexpr size_t MERGE_BUFFER_FLOOR = 16; // Smaller per-run buffers make merging all seek and no read
+
+    // Buffer sizes that keep every phase of calculateExternal within the memory budget. The phases run one
+    // after another and each frees its buffers before the next starts, so peak use is the largest phase.
+    struct MergePlan {
+        size_t runCapacity; // Per column while spilling runs; two columns plus the radix sort scratch at once
+        size_t maxFanIn; // Runs merged at once, at least 2
+        size_t reduceBuffer; // Per reader and for the output while reducing, (maxFanIn + 1) buffers in total
+        size_t streamElements; // Per merged stream in the final pass, split across its runs; three streams at once
+    };
+
+    // Below these sizes the comparison sort wins over the radix passes and thread startup
+    static constexpr size_t RADIX_SORT_THRESHOLD = size_t{1} << 10;
+    static constexpr size_t PARALLEL_SORT_THRESHOLD = size_t{1} << 20;
+    static constexpr size_t PARALLEL_REDUCE_THRESHOLD = size_t{1} << 22;
+
+    template<aoc::sort::RadixSortable T>
+    static void sortList(std::vector<T> &list);
+
+    // AbsoluteDifference and Product on int32/int64 lists are routed to the SIMD kernels
     template<aoc::templates::Numeric T, aoc::templates::ListBinaryOperation<T> BinaryOp>
     [[nodiscard]] static T calculateWithLists(std::span<const T> left, std::span<const T> right, BinaryOp op) noexcept;
 
+    // Expects both spans sorted and of equal length
+    template<aoc::templates::Numeric T>
+    [[nodiscard]] static ListResults<T> calculateWithLists(std::span<const T> sortedLeft,
+                                                           std::span<const T> sortedRight) noexcept;
+
+    // Fails if the budget cannot give every reader MERGE_BUFFER_FLOOR values
+    template<aoc::sort::RadixSortable T>
+    static std::expected<MergePlan, aoc::exceptions::AocException> mergePlan(size_t memoryBudget) noexcept;
+
+    template<aoc::sort::RadixSortable T>
+    static std::expected<ListResults<T>, aoc::exceptions::AocException> calculateExternal(
+        const std::filesystem::path &path, const ExternalSortConfig &config) noexcept;
+
+    // Same span interface as calculateWithLists, so exact and approximate modes can be compared directly
+    template<std::integral T>
+    static std::expected<SimilarityEstimate<T>, aoc::exceptions::AocException> estimateSimilarity(
+        std::span<const T> left, std::span<const T> right, const SketchConfig &config) noexcept;
+
+    template<std::integral T>
+    static std::expected<SimilarityEstimate<T>, aoc::exceptions::AocException> estimateSimilarity(
+        const std::filesystem::path &path, const SketchConfig &config) noexcept;
+
     template<aoc::templates::Numeric T>
     static std::expected<NumberLists<T>, aoc::exceptions::AocException> readLists(
         const std::filesystem::path &path) noexcept;
 
+    // Both lists sorted, from the binary cache next to the text input; parses and (re)writes the cache
+    // when it is missing, older than the text or holds a different element type
+    template<aoc::sort::RadixSortable T>
+    static std::expected<NumberLists<T>, aoc::exceptions::AocException> loadSortedLists(
+        const std::filesystem::path &path) noexcept;
+
+    template<aoc::templates::Numeric T>
+    static std::expected<void, aoc::exceptions::AocException> writeListCache(
+        const std::filesystem::path &path, const NumberLists<T> &lists, bool sorted) noexcept;
+
+    template<aoc::templates::Numeric T>
+    static std::expected<CachedLists<T>, aoc::exceptions::AocException> readListCache(
+        const std::filesystem::path &path) noexcept;
+
+    static std::filesystem::path cachePathFor(const std::filesystem::path &textPath);
+
+    // Decodes the leading run of records matching the layout of the first line, returns the bytes consumed
+    template<std::integral T>
+    static size_t parseFixedWidth(std::string_view text, std::vector<T> &left, std::vector<T> &right);
+
+    // Layout of the first line if it is "<digits><spaces><digits><line end>" with numbers that fit T
+    template<std::integral T>
+    [[nodiscard]] static std::optional<FixedLayout> detectLayout(std::string_view text) noexcept;
+
+    // Feeds every (left, right) pair of the stream to the consumer without storing the lists
+    template<aoc::templates::Numeric T, typename Consumer>
+    static std::expected<void, aoc::exceptions::AocException> forEachPair(
+        std::istream &stream, Consumer &&consumer) noexcept;
+
     static std::expected<std::ifstream, aoc::exceptions::AocException> openFile(
         const std::filesystem::path &path) noexcept;
 
@@ -56,83 +334,828 @@ constexpr Day01::NumberLists<T>::NumberLists(std::vector<T> l, std::vector<T> r)
 template<aoc::templates::Numeric T>
 size_t Day01::NumberLists<T>::size() const noexcept { return left.size(); }
 
+template<std::integral T>
+std::expected<Day01::IncrementalLists<T>, aoc::exceptions::AocException> Day01::IncrementalLists<T>::create() noexcept {
+    return IncrementalLists{};
+}
+
+template<std::integral T>
+std::expected<Day01::IncrementalLists<T>, aoc::exceptions::AocException> Day01::IncrementalLists<T>::fromLists(
+    const NumberLists<T> &lists) noexcept {
+    try {
+        IncrementalLists incremental;
+        std::vector<Entry> entries;
+        entries.reserve(lists.left.size() + lists.right.size());
+        for (const T value: lists.left) {
+            entries.push_back({value, 1});
+            ++incremental.counts[value].first;
+        }
+        for (const T value: lists.right) {
+            entries.push_back({value, -1});
+            ++incremental.counts[value].second;
+        }
+        std::ranges::sort(entries);
+        incremental.lefts = lists.left.size();
+        incremental.rights = lists.right.size();
+        for (const auto &[value, count]: incremental.counts) {
+            incremental.similarityScore += value * static_cast<T>(count.first * count.second);
+        }
+
+        const size_t size = incremental.blockSize();
+        int64_t level = 0;
+        for (size_t first = 0; first < entries.size(); first += size) {
+            Block block;
+            block.entries.assign(entries.begin() + static_cast<std::ptrdiff_t>(first),
+                                 entries.begin() + static_cast<std::ptrdiff_t>(std::min(first + size, entries.size())));
+            block.entryLevel = level;
+            for (const auto &entry: block.entries) level += entry.step;
+            reserveLevels(block, block.entries.size());
+            incremental.blocks.push_back(std::move(block));
+        }
+        for (size_t i = 0; i < incremental.blocks.size(); ++i) {
+            incremental.rebuild(i);
+        }
+        return incremental;
+    } catch (const std::exception &) {
+        return std::unexpected(aoc::exceptions::AlgorithmError("Failed to allocate incremental lists"));
+    }
+}
+
+template<std::integral T>
+std::expected<void, aoc::exceptions::AocException> Day01::IncrementalLists<T>::insertLeft(const T value) noexcept {
+    return update({value, 1}, true);
+}
+
+template<std::integral T>
+std::expected<void, aoc::exceptions::AocException> Day01::IncrementalLists<T>::eraseLeft(const T value) noexcept {
+    return update({value, 1}, false);
+}
+
+template<std::integral T>
+std::expected<void, aoc::exceptions::AocException> Day01::IncrementalLists<T>::insertRight(const T value) noexcept {
+    return update({value, -1}, true);
+}
+
+template<std::integral T>
+std::expected<void, aoc::exceptions::AocException> Day01::IncrementalLists<T>::eraseRight(const T value) noexcept {
+    return update({value, -1}, false);
+}
+
+template<std::integral T>
+T Day01::IncrementalLists<T>::distance() const noexcept { return static_cast<T>(total); }
+
+template<std::integral T>
+T Day01::IncrementalLists<T>::similarity() const noexcept { return similarityScore; }
+
+template<std::integral T>
+size_t Day01::IncrementalLists<T>::leftSize() const noexcept { return lefts; }
+
+template<std::integral T>
+size_t Day01::IncrementalLists<T>::rightSize() const noexcept { return rights; }
+
+template<std::integral T>
+std::optional<T> Day01::IncrementalLists<T>::nthLeft(const size_t rank) const noexcept { return nth(true, rank); }
+
+template<std::integral T>
+std::optional<T> Day01::IncrementalLists<T>::nthRight(const size_t rank) const noexcept { return nth(false, rank); }
+
+template<std::integral T>
+std::expected<void, aoc::exceptions::AocException> Day01::IncrementalLists<T>::update(
+    const Entry entry, const bool insert) noexcept {
+    const bool leftSide = entry.step > 0;
+    const auto known = counts.find(entry.value);
+    if (!insert && (known == counts.end() || (leftSide ? known->second.first : known->second.second) == 0)) {
+        return std::unexpected(aoc::exceptions::AlgorithmError(
+            std::format("value {} is not in the list", entry.value)));
+    }
+
+    // Everything that can allocate comes first, so a failure leaves the lists as they were
+    if (blocks.empty() && insert) {
+        try {
+            blocks.emplace_back();
+        } catch (const std::exception &) {
+            return std::unexpected(aoc::exceptions::AlgorithmError("Failed to allocate incremental lists"));
+        }
+    }
+    const size_t index = findBlock(entry);
+    auto &entries = blocks[index].entries;
+    const auto position = std::ranges::lower_bound(entries, entry) - entries.begin();
+    if (insert) {
+        try {
+            reserveLevels(blocks[index], entries.size() + 1);
+            entries.insert(entries.begin() + position, entry);
+            try {
+                counts.try_emplace(entry.value);
+            } catch (const std::exception &) {
+                entries.erase(entries.begin() + position);
+                throw;
+            }
+        } catch (const std::exception &) {
+            return std::unexpected(aoc::exceptions::AlgorithmError("Failed to allocate incremental lists"));
+        }
+    } else {
+        entries.erase(entries.begin() + position); // The count above guarantees an equal entry in this block
+    }
+
+    auto &[leftCount, rightCount] = counts.find(entry.value)->second;
+    const int64_t delta = insert ? 1 : -1;
+    similarityScore += static_cast<T>(delta * (leftSide ? rightCount : leftCount)) * entry.value;
+    (leftSide ? leftCount : rightCount) += delta;
+    if (leftCount == 0 && rightCount == 0) counts.erase(entry.value);
+    auto &listSize = leftSide ? lefts : rights;
+    listSize = insert ? listSize + 1 : listSize - 1;
+
+    // Later blocks start one level higher or lower; the block before may have lost or gained its last gap
+    const int64_t levelDelta = insert ? entry.step : -entry.step;
+    for (size_t i = index + 1; i < blocks.size(); ++i) {
+        shift(blocks[i], levelDelta);
+    }
+    rebuild(index);
+    if (index > 0) rebuild(index - 1);
+    try {
+        rebalance(index);
+    } catch (const std::exception &) {
+        // The blocks are still exact, the next update of this block tries again
+    }
+    return {};
+}
+
+template<std::integral T>
+size_t Day01::IncrementalLists<T>::blockSize() const noexcept {
+    const auto size = static_cast<double>(lefts + rights);
+    return std::max(MIN_BLOCK, std::bit_ceil(static_cast<size_t>(std::sqrt(size))));
+}
+
+template<std::integral T>
+size_t Day01::IncrementalLists<T>::findBlock(const Entry &entry) const noexcept {
+    const auto found = std::ranges::partition_point(blocks, [&entry](const Block &block) {
+        return !block.entries.empty() && block.entries.back() < entry;
+    });
+    return std::min(static_cast<size_t>(found - blocks.begin()), blocks.size() - 1);
+}
+
+template<std::integral T>
+void Day01::IncrementalLists<T>::reserveLevels(Block &block, const size_t entries) {
+    // Levels relative to entryLevel lie in [-entries, entries] since every entry moves by one
+    block.atLeast.reserve(2 * entries + 2);
+}
+
+template<std::integral T>
+void Day01::IncrementalLists<T>::rebuild(const size_t index) noexcept {
+    Block &block = blocks[index];
+    const auto size = static_cast<int64_t>(block.entries.size());
+    const Entry *next = nullptr;
+    for (size_t i = index + 1; i < blocks.size() && next == nullptr; ++i) {
+        if (!blocks[i].entries.empty()) next = &blocks[i].entries.front();
+    }
+
+    // Capacity comes from reserveLevels, so the weights are built in place
+    auto &weights = block.atLeast;
+    weights.assign(static_cast<size_t>(2 * size + 2), 0);
+    int64_t level = 0;
+    block.lefts = 0;
+    for (size_t k = 0; k < block.entries.size(); ++k) {
+        const Entry &entry = block.entries[k];
+        level += entry.step;
+        block.lefts += entry.step > 0 ? 1 : 0;
+        const Entry *after = k + 1 < block.entries.size() ? &block.entries[k + 1] : next;
+        if (after != nullptr) {
+            weights[static_cast<size_t>(level + size)] += static_cast<int64_t>(after->value) -
+                                                           static_cast<int64_t>(entry.value);
+        }
+    }
+
+    total -= block.contribution;
+    block.contribution = 0;
+    for (int64_t r = -size; r <= size; ++r) {
+        const int64_t imbalance = block.entryLevel + r;
+        block.contribution += weights[static_cast<size_t>(r + size)] * (imbalance < 0 ? -imbalance : imbalance);
+    }
+    for (size_t i = weights.size() - 1; i-- > 0;) {
+        weights[i] += weights[i + 1];
+    }
+
+    total += block.contribution;
+}
+
+template<std::integral T>
+void Day01::IncrementalLists<T>::shift(Block &block, const int64_t delta) noexcept {
+    if (block.entries.empty()) return;
+    const int64_t weight = block.atLeast.front();
+    // Gaps at or above zero grow by one per unit of weight when moving up, the rest shrink; mirrored for down
+    const int64_t change = delta > 0
+                               ? 2 * weightAtLeast(block, -block.entryLevel) - weight
+                               : weight - 2 * weightAtLeast(block, 1 - block.entryLevel);
+    block.contribution += change;
+    total += change;
+    block.entryLevel += delta;
+}
+
+template<std::integral T>
+int64_t Day01::IncrementalLists<T>::weightAtLeast(const Block &block, const int64_t level) noexcept {
+    const auto size = static_cast<int64_t>(block.entries.size());
+    const int64_t index = std::clamp<int64_t>(level + size, 0, 2 * size + 1);
+    return block.atLeast[static_cast<size_t>(index)];
+}
+
+template<std::integral T>
+void Day01::IncrementalLists<T>::rebalance(const size_t index) {
+    const size_t target = blockSize();
+    Block &block = blocks[index];
+    if (block.entries.size() > 2 * target) {
+        const size_t half = block.entries.size() / 2;
+        Block upper;
+        upper.entries.assign(block.entries.begin() + static_cast<std::ptrdiff_t>(half), block.entries.end());
+        reserveLevels(upper, upper.entries.size());
+        upper.entryLevel = block.entryLevel;
+        for (size_t k = 0; k < half; ++k) upper.entryLevel += block.entries[k].step;
+        blocks.insert(blocks.begin() + static_cast<std::ptrdiff_t>(index) + 1, std::move(upper));
+
+        // No allocation from here on
+        auto &lowerEntries = blocks[index].entries;
+        lowerEntries.erase(lowerEntries.begin() + static_cast<std::ptrdiff_t>(half), lowerEntries.end());
+        rebuild(index);
+        rebuild(index + 1);
+    } else if (block.entries.size() < target / 4 && blocks.size() > 1) {
+        // Fold into the following block, or the previous one for the last block
+        const size_t lower = index + 1 < blocks.size() ? index : index - 1;
+        Block &first = blocks[lower];
+        const Block &second = blocks[lower + 1];
+        const size_t merged = first.entries.size() + second.entries.size();
+        first.entries.reserve(merged);
+        reserveLevels(first, merged);
+
+        // No allocation from here on
+        total -= second.contribution;
+        first.entries.insert(first.entries.end(), second.entries.begin(), second.entries.end());
+        blocks.erase(blocks.begin() + static_cast<std::ptrdiff_t>(lower) + 1);
+        rebuild(lower);
+        if (blocks[lower].entries.size() > 2 * target) rebalance(lower);
+    }
+}
+
+template<std::integral T>
+std::optional<T> Day01::IncrementalLists<T>::nth(const bool leftSide, size_t rank) const noexcept {
+    for (const auto &block: blocks) {
+        const size_t inBlock = leftSide ? block.lefts : block.entries.size() - block.lefts;
+        if (rank >= inBlock) {
+            rank -= inBlock;
+            continue;
+        }
+        for (const auto &entry: block.entries) {
+            if ((entry.step > 0) == leftSide && rank-- == 0) return entry.value;
+        }
+    }
+    return std::nullopt;
+}
+
 inline void Day01::partOne() {
-    auto lists = readLists<int64_t>(INPUT_FILE);
+    const auto lists = loadSortedLists<int64_t>(INPUT_FILE);
     if (!lists) {
         std::println("Error reading lists: {}", lists.error().what());
         return;
     }
-    //Simple ordered sorting
-    std::ranges::sort(lists->left);
-    std::ranges::sort(lists->right);
 
-    auto total = calculateWithLists<int64_t>(lists->left, lists->right,
-                                             [](const int64_t a, const int64_t b) { return std::abs(a - b); });
+    auto total = calculateWithLists<int64_t>(lists->left, lists->right, aoc::simd::AbsoluteDifference{});
 
     std::println("Total is {}", total);
 }
 
 inline void Day01::partTwo() {
-    const auto lists = readLists<int64_t>(INPUT_FILE);
+    // Sorted lists turn the frequency lookup into a merge-join, no hashing needed
+    const auto lists = loadSortedLists<int64_t>(INPUT_FILE);
     if (!lists) {
         std::println("Error reading lists: {}", lists.error().what());
         return;
     }
 
-    // Create frequency map
-    std::unordered_map<int64_t, int64_t> frequency;
-    frequency.reserve(lists->size());
-    for (const int64_t num: lists->right) {
-        frequency[num]++;
+    const auto results = calculateWithLists<int64_t>(lists->left, lists->right);
+
+    std::println("Similarity score is {}", results.similarity);
+}
+
+inline void Day01::bothParts() {
+    // One load of the sorted lists serves both answers
+    const auto lists = loadSortedLists<int64_t>(INPUT_FILE);
+    if (!lists) {
+        std::println("Error reading lists: {}", lists.error().what());
+        return;
     }
-    // O(1) lookup
-    auto similarityScore =
-            calculateWithLists<int64_t>(lists->left, lists->right, [&frequency](const int64_t left, const int64_t) {
-                return left * frequency[left];
-            });
 
-    std::println("Similarity score is {}", similarityScore);
+    const auto [distance, similarity] = calculateWithLists<int64_t>(lists->left, lists->right);
+
+    std::println("Total is {}, similarity score is {} (single pass)", distance, similarity);
+}
+
+inline void Day01::bothPartsExternal(const size_t memoryBudget) {
+    std::error_code ec;
+    const ExternalSortConfig config{memoryBudget, std::filesystem::temp_directory_path(ec)};
+    if (ec) {
+        std::println("Error finding temp directory: {}", ec.message());
+        return;
+    }
+
+    const auto results = calculateExternal<int64_t>(INPUT_FILE, config);
+    if (!results) {
+        std::println("Error sorting lists: {}", results.error().what());
+        return;
+    }
+
+    std::println("Total is {}, similarity score is {} (external sort)", results->distance, results->similarity);
+}
+
+inline void Day01::partTwoApproximate(const size_t sketchWidth, const size_t sketchDepth) {
+    const auto estimate = estimateSimilarity<int64_t>(INPUT_FILE, SketchConfig{sketchWidth, sketchDepth});
+    if (!estimate) {
+        std::println("Error estimating similarity: {}", estimate.error().what());
+        return;
+    }
+
+    std::println("Similarity score is about {} (at most {} too high with probability {:.4f})",
+                 estimate->estimate, estimate->errorBound, estimate->confidence);
+}
+
+template<aoc::sort::RadixSortable T>
+void Day01::sortList(std::vector<T> &list) {
+    if (list.size() >= PARALLEL_SORT_THRESHOLD) {
+        aoc::sort::parallelRadixSort<T>(list);
+    } else if (list.size() >= RADIX_SORT_THRESHOLD) {
+        aoc::sort::radixSort<T>(list);
+    } else {
+        std::ranges::sort(list);
+    }
 }
 
 template<aoc::templates::Numeric T, aoc::templates::ListBinaryOperation<T> BinaryOp>
 T Day01::calculateWithLists(std::span<const T> left, std::span<const T> right, BinaryOp op) noexcept {
-    return std::transform_reduce(
-        left.begin(), left.end(), // First range
-        right.begin(), // Second range
-        T{0}, // Initial value
-        std::plus(), // Reduction operation
-        op // Transform operation (lambda)
-    );
+    // TBB may throw (bad_alloc, exceptions captured from tasks), in which case the sequential kernel runs instead
+    if constexpr (aoc::simd::SimdInteger<T> && std::same_as<BinaryOp, aoc::simd::AbsoluteDifference>) {
+        if (left.size() >= PARALLEL_REDUCE_THRESHOLD) {
+            try {
+                return aoc::simd::parallelSumAbsDiff<T>(left, right);
+            } catch (const std::exception &) {
+            }
+        }
+        return aoc::simd::sumAbsDiff<T>(left, right);
+    } else if constexpr (aoc::simd::SimdInteger<T> && std::same_as<BinaryOp, aoc::simd::Product>) {
+        if (left.size() >= PARALLEL_REDUCE_THRESHOLD) {
+            try {
+                return aoc::simd::parallelSumProducts<T>(left, right);
+            } catch (const std::exception &) {
+            }
+        }
+        return aoc::simd::sumProducts<T>(left, right);
+    } else {
+        return std::transform_reduce(
+            left.begin(), left.end(), // First range
+            right.begin(), // Second range
+            T{0}, // Initial value
+            std::plus(), // Reduction operation
+            op // Transform operation (lambda)
+        );
+    }
 }
 
 template<aoc::templates::Numeric T>
-std::expected<Day01::NumberLists<T>, aoc::exceptions::AocException> Day01::readLists(
-    const std::filesystem::path &path) noexcept {
+Day01::ListResults<T> Day01::calculateWithLists(std::span<const T> sortedLeft,
+                                                std::span<const T> sortedRight) noexcept {
+    ListResults<T> results{T{0}, T{0}};
+    size_t rightIdx = 0; // Merge cursor, only ever moves forward
+    T matches{0}; // Occurrences of the current left value in the right list
+
+    for (size_t i = 0; i < sortedLeft.size(); ++i) {
+        const T value = sortedLeft[i];
+        const T other = sortedRight[i];
+        results.distance += value > other ? value - other : other - value;
+
+        // Repeated left values reuse the count of the previous run
+        if (i == 0 || value != sortedLeft[i - 1]) {
+            while (rightIdx < sortedRight.size() && sortedRight[rightIdx] < value) ++rightIdx;
+            matches = T{0};
+            while (rightIdx < sortedRight.size() && sortedRight[rightIdx] == value) {
+                ++rightIdx;
+                ++matches;
+            }
+        }
+        results.similarity += value * matches;
+    }
+
+    return results;
+}
+
+template<aoc::sort::RadixSortable T>
+std::expected<Day01::MergePlan, aoc::exceptions::AocException> Day01::mergePlan(const size_t memoryBudget) noexcept {
+    // The final pass reads three merged streams at once, so each gets a third of the budget
+    const size_t streamElements = memoryBudget / (3 * sizeof(T));
+    if (streamElements < 2 * MERGE_BUFFER_FLOOR) {
+        return std::unexpected(aoc::exceptions::AlgorithmError("Memory budget too small to merge sorted runs"));
+    }
+    // Large buffers first; fan-in only grows once every run can have MIN_RUN_BUFFER values
+    const size_t maxFanIn = std::max<size_t>(streamElements / MIN_RUN_BUFFER, 2);
+    const size_t reduceBuffer = memoryBudget / ((maxFanIn + 1) * sizeof(T));
+    return MergePlan{streamElements, maxFanIn, reduceBuffer, streamElements};
+}
+
+template<aoc::sort::RadixSortable T>
+std::expected<Day01::ListResults<T>, aoc::exceptions::AocException> Day01::calculateExternal(
+    const std::filesystem::path &path, const ExternalSortConfig &config) noexcept {
     auto stream = openFile(path);
     if (!stream) {
         return std::unexpected(stream.error());
     }
+    const auto plan = mergePlan<T>(config.memoryBudget);
+    if (!plan) {
+        return std::unexpected(plan.error());
+    }
+    auto directory = aoc::sort::TempDirectory::create(config.tempDirectory);
+    if (!directory) {
+        return std::unexpected(directory.error());
+    }
+
+    try {
+        // Spill phase in its own scope, so no column buffer outlives it into the merges
+        std::expected<std::vector<std::filesystem::path>, aoc::exceptions::AocException> leftRuns;
+        std::expected<std::vector<std::filesystem::path>, aoc::exceptions::AocException> rightRuns;
+        {
+            aoc::sort::RunWriter<T> leftWriter(*directory, plan->runCapacity);
+            aoc::sort::RunWriter<T> rightWriter(*directory, plan->runCapacity);
+
+            auto parsed = forEachPair<T>(stream.value(), [&](const T left, const T right) {
+                if (auto pushed = leftWriter.push(left); !pushed) return pushed;
+                return rightWriter.push(right);
+            });
+            if (!parsed) return std::unexpected(parsed.error());
+
+            leftRuns = leftWriter.finish();
+            if (!leftRuns) return std::unexpected(leftRuns.error());
+            rightRuns = rightWriter.finish();
+            if (!rightRuns) return std::unexpected(rightRuns.error());
+        }
+
+        leftRuns = aoc::sort::reduceRuns<T>(std::move(*leftRuns), *directory, plan->maxFanIn, plan->reduceBuffer);
+        if (!leftRuns) return std::unexpected(leftRuns.error());
+        rightRuns = aoc::sort::reduceRuns<T>(std::move(*rightRuns), *directory, plan->maxFanIn, plan->reduceBuffer);
+        if (!rightRuns) return std::unexpected(rightRuns.error());
+
+        const size_t fanIn = std::max({leftRuns->size(), rightRuns->size(), size_t{1}});
+        const size_t bufferElements = plan->streamElements / fanIn;
+        auto leftStream = aoc::sort::RunMerger<T>::open(*leftRuns, bufferElements);
+        if (!leftStream) return std::unexpected(leftStream.error());
+        auto rightStream = aoc::sort::RunMerger<T>::open(*rightRuns, bufferElements);
+        if (!rightStream) return std::unexpected(rightStream.error());
+        auto rightJoin = aoc::sort::RunMerger<T>::open(*rightRuns, bufferElements);
+        if (!rightJoin) return std::unexpected(rightJoin.error());
+
+        // Same reduction as the sorted span overload, with the right list read twice: aligned and merge-joined
+        ListResults<T> results{T{0}, T{0}};
+        T matches{0};
+        T previous{0};
+        bool first = true;
+        for (; !leftStream->empty() && !rightStream->empty(); leftStream->pop(), rightStream->pop()) {
+            const T value = leftStream->top();
+            const T other = rightStream->top();
+            results.distance += value > other ? value - other : other - value;
+
+            if (first || value != previous) {
+                while (!rightJoin->empty() && rightJoin->top() < value) rightJoin->pop();
+                matches = T{0};
+                while (!rightJoin->empty() && rightJoin->top() == value) {
+                    rightJoin->pop();
+                    ++matches;
+                }
+                previous = value;
+                first = false;
+            }
+            results.similarity += value * matches;
+        }
+
+        if (leftStream->failed() || rightStream->failed() || rightJoin->failed()) {
+            return std::unexpected(aoc::exceptions::DataFormatError("Sorted run could not be read back"));
+        }
+        return results;
+    } catch (const std::exception &) {
+        return std::unexpected(aoc::exceptions::AlgorithmError("External sort failed"));
+    }
+}
+
+template<std::integral T>
+Day01::SimilaritySketch<T>::SimilaritySketch(const SketchConfig &config): leftWeights(config.width, config.depth),
+                                                                         rightCounts(config.width, config.depth) {
+}
+
+template<std::integral T>
+std::expected<void, aoc::exceptions::AocException> Day01::SimilaritySketch<T>::add(const T left,
+                                                                                   const T right) noexcept {
+    // Count-Min only bounds the error for non-negative weights
+    if (left < T{0} || right < T{0}) {
+        return std::unexpected(aoc::exceptions::DataFormatError("Sketch estimate needs non-negative values"));
+    }
+    leftWeights.add(static_cast<uint64_t>(left), static_cast<int64_t>(left));
+    rightCounts.add(static_cast<uint64_t>(right));
+    return {};
+}
+
+template<std::integral T>
+std::expected<Day01::SimilarityEstimate<T>, aoc::exceptions::AocException>
+Day01::SimilaritySketch<T>::result() const noexcept {
+    auto estimate = leftWeights.innerProduct(rightCounts);
+    if (!estimate) {
+        return std::unexpected(estimate.error());
+    }
+    if (!std::in_range<T>(*estimate)) {
+        return std::unexpected(aoc::exceptions::AlgorithmError("Sketch estimate does not fit the value type"));
+    }
+    const double bound = std::ceil(leftWeights.epsilon() * static_cast<double>(leftWeights.totalWeight()) *
+                                   static_cast<double>(rightCounts.totalWeight()));
+    const double largest = static_cast<double>(std::numeric_limits<T>::max());
+    return SimilarityEstimate<T>{
+        static_cast<T>(*estimate),
+        bound >= largest ? std::numeric_limits<T>::max() : static_cast<T>(bound),
+        1.0 - leftWeights.delta()
+    };
+}
+
+template<std::integral T>
+size_t Day01::SimilaritySketch<T>::memoryBytes() const noexcept {
+    return leftWeights.memoryBytes() + rightCounts.memoryBytes();
+}
+
+template<std::integral T>
+std::expected<Day01::SimilarityEstimate<T>, aoc::exceptions::AocException> Day01::estimateSimilarity(
+    std::span<const T> left, std::span<const T> right, const SketchConfig &config) noexcept {
+    try {
+        SimilaritySketch<T> sketch(config);
+        for (size_t i = 0; i < std::min(left.size(), right.size()); ++i) {
+            if (auto added = sketch.add(left[i], right[i]); !added) {
+                return std::unexpected(added.error());
+            }
+        }
+        return sketch.result();
+    } catch (const std::exception &) {
+        return std::unexpected(aoc::exceptions::AlgorithmError("Failed to allocate similarity sketch"));
+    }
+}
+
+template<std::integral T>
+std::expected<Day01::SimilarityEstimate<T>, aoc::exceptions::AocException> Day01::estimateSimilarity(
+    const std::filesystem::path &path, const SketchConfig &config) noexcept {
+    auto stream = openFile(path);
+    if (!stream) {
+        return std::unexpected(stream.error());
+    }
+
+    try {
+        // Nothing but the sketches is kept, so memory does not grow with the input
+        SimilaritySketch<T> sketch(config);
+        auto parsed = forEachPair<T>(stream.value(), [&](const T left, const T right) {
+            return sketch.add(left, right);
+        });
+        if (!parsed) {
+            return std::unexpected(parsed.error());
+        }
+        return sketch.result();
+    } catch (const std::exception &) {
+        return std::unexpected(aoc::exceptions::AlgorithmError("Failed to allocate similarity sketch"));
+    }
+}
+
+template<aoc::templates::Numeric T>
+std::expected<Day01::NumberLists<T>, aoc::exceptions::AocException> Day01::readLists(
+    const std::filesystem::path &path) noexcept {
+    auto mapped = aoc::MappedFile::open(path);
+    if (!mapped) {
+        return std::unexpected(mapped.error());
+    }
+    const std::string_view text{reinterpret_cast<const char *>(mapped->bytes().data()), mapped->bytes().size()};
     std::vector<T> listOne;
     std::vector<T> listTwo;
+
+    try {
+        size_t consumed = 0;
+        if constexpr (std::integral<T>) {
+            consumed = parseFixedWidth<T>(text, listOne, listTwo);
+        }
+
+        // Whatever the fixed width path did not take goes through the general parser, errors included
+        std::ispanstream rest{std::span<const char>{text.substr(consumed)}};
+        auto parsed = forEachPair<T>(rest, [&](const T num1, const T num2)
+            -> std::expected<void, aoc::exceptions::AocException> {
+                listOne.push_back(num1);
+                listTwo.push_back(num2);
+                return {};
+            });
+        if (!parsed) {
+            return std::unexpected(parsed.error());
+        }
+    } catch (const std::exception &) {
+        return std::unexpected(aoc::exceptions::AlgorithmError("Failed to allocate lists"));
+    }
+
+    //If the vectors are not equal, something went wrong reading the data
+    if (listOne.size() != listTwo.size()) {
+        return std::unexpected(aoc::exceptions::DataFormatError(
+            std::format("vectors are not equal: {} != {}", listOne.size(), listTwo.size())));
+    }
+
+    return NumberLists<T>(std::move(listOne), std::move(listTwo));
+}
+
+template<std::integral T>
+size_t Day01::parseFixedWidth(const std::string_view text, std::vector<T> &left, std::vector<T> &right) {
+    if constexpr (!aoc::swar::SUPPORTED) {
+        return 0;
+    } else {
+        const auto layout = detectLayout<T>(text);
+        if (!layout) return 0;
+
+        const size_t recordSize = layout->recordSize();
+        const size_t rightStart = layout->leftDigits + layout->gap;
+        const size_t lineEndStart = rightStart + layout->rightDigits;
+        left.reserve(text.size() / recordSize);
+        right.reserve(text.size() / recordSize);
+
+        size_t offset = 0;
+        for (; offset + recordSize <= text.size(); offset += recordSize) {
+            uint32_t first;
+            uint32_t second;
+            if (!aoc::swar::parseDigits(text, offset, layout->leftDigits, first) ||
+                !aoc::swar::parseDigits(text, offset + rightStart, layout->rightDigits, second)) {
+                break;
+            }
+            // The gap and line end must match byte for byte, anything else is left to the general parser
+            if (text.compare(offset + layout->leftDigits, layout->gap, text, layout->leftDigits, layout->gap) != 0 ||
+                text.compare(offset + lineEndStart, layout->lineEnd, text, lineEndStart, layout->lineEnd) != 0) {
+                break;
+            }
+            left.push_back(static_cast<T>(first));
+            right.push_back(static_cast<T>(second));
+        }
+        return offset;
+    }
+}
+
+template<std::integral T>
+std::optional<Day01::FixedLayout> Day01::detectLayout(const std::string_view text) noexcept {
+    const auto isDigit = [](const char c) { return c >= '0' && c <= '9'; };
+    const auto runLength = [&](size_t from, auto &&predicate) {
+        size_t end = from;
+        while (end < text.size() && predicate(text[end])) ++end;
+        return end - from;
+    };
+    const size_t maxDigits = std::min<size_t>(aoc::swar::MAX_DIGITS, std::numeric_limits<T>::digits10);
+
+    FixedLayout layout{};
+    layout.leftDigits = runLength(0, isDigit);
+    layout.gap = runLength(layout.leftDigits, [](const char c) { return c == ' '; });
+    layout.rightDigits = runLength(layout.leftDigits + layout.gap, isDigit);
+    const size_t lineEndStart = layout.leftDigits + layout.gap + layout.rightDigits;
+    if (text.substr(lineEndStart, 1) == "\n") {
+        layout.lineEnd = 1;
+    } else if (text.substr(lineEndStart, 2) == "\r\n") {
+        layout.lineEnd = 2;
+    }
+
+    if (layout.leftDigits == 0 || layout.leftDigits > maxDigits || layout.gap == 0 ||
+        layout.rightDigits == 0 || layout.rightDigits > maxDigits || layout.lineEnd == 0) {
+        return std::nullopt;
+    }
+    return layout;
+}
+
+template<aoc::sort::RadixSortable T>
+std::expected<Day01::NumberLists<T>, aoc::exceptions::AocException> Day01::loadSortedLists(
+    const std::filesystem::path &path) noexcept {
+    const auto cachePath = cachePathFor(path);
+    std::error_code textError;
+    std::error_code cacheError;
+    const auto textTime = std::filesystem::last_write_time(path, textError);
+    const auto cacheTime = std::filesystem::last_write_time(cachePath, cacheError);
+
+    if (!cacheError && (textError || cacheTime >= textTime)) {
+        if (auto cached = readListCache<T>(cachePath); cached) {
+            if (!cached->sorted) {
+                sortList(cached->lists.left);
+                sortList(cached->lists.right);
+            }
+            return std::move(cached->lists);
+        }
+        // Unreadable or foreign caches fall through and are replaced
+    }
+
+    auto lists = readLists<T>(path);
+    if (!lists) {
+        return std::unexpected(lists.error());
+    }
+    sortList(lists->left);
+    sortList(lists->right);
+    (void) writeListCache<T>(cachePath, *lists, true); // A missing cache only costs the next run a parse
+    return lists;
+}
+
+template<aoc::templates::Numeric T>
+std::expected<void, aoc::exceptions::AocException> Day01::writeListCache(
+    const std::filesystem::path &path, const NumberLists<T> &lists, const bool sorted) noexcept {
+    if (lists.left.size() != lists.right.size()) {
+        return std::unexpected(aoc::exceptions::DataFormatError(
+            std::format("vectors are not equal: {} != {}", lists.left.size(), lists.right.size())));
+    }
+
+    // Written next to the target and renamed over it, so readers never see a half written cache
+    auto partial = path;
+    partial += ".partial";
+    const CacheHeader header{CACHE_MAGIC, CACHE_VERSION, cacheElementTag<T>(), lists.left.size(),
+                             sorted ? CACHE_SORTED : 0, 0};
+    {
+        std::ofstream out(partial, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return std::unexpected(aoc::exceptions::FileWriteError(partial.string()));
+        }
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(lists.left.data()),
+                  static_cast<std::streamsize>(lists.left.size() * sizeof(T)));
+        out.write(reinterpret_cast<const char *>(lists.right.data()),
+                  static_cast<std::streamsize>(lists.right.size() * sizeof(T)));
+        if (!out) {
+            return std::unexpected(aoc::exceptions::FileWriteError(partial.string()));
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(partial, path, ec);
+    if (ec) {
+        std::filesystem::remove(partial, ec);
+        return std::unexpected(aoc::exceptions::FileWriteError(path.string()));
+    }
+    return {};
+}
+
+template<aoc::templates::Numeric T>
+std::expected<Day01::CachedLists<T>, aoc::exceptions::AocException> Day01::readListCache(
+    const std::filesystem::path &path) noexcept {
+    auto mapped = aoc::MappedFile::open(path);
+    if (!mapped) {
+        return std::unexpected(mapped.error());
+    }
+    const auto bytes = mapped->bytes();
+
+    CacheHeader header{};
+    if (bytes.size() < sizeof(header)) {
+        return std::unexpected(aoc::exceptions::DataFormatError("list cache is truncated"));
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION) {
+        return std::unexpected(aoc::exceptions::DataFormatError("not a list cache"));
+    }
+    if (header.elementTag != cacheElementTag<T>()) {
+        return std::unexpected(aoc::exceptions::DataFormatError("list cache holds another element type"));
+    }
+    if (header.count > (bytes.size() - sizeof(header)) / (2 * sizeof(T)) ||
+        bytes.size() != sizeof(header) + 2 * header.count * sizeof(T)) {
+        return std::unexpected(aoc::exceptions::DataFormatError("list cache size does not match its header"));
+    }
+
+    try {
+        // One copy per column straight out of the page cache
+        const auto count = static_cast<size_t>(header.count);
+        std::vector<T> left(count);
+        std::vector<T> right(count);
+        std::memcpy(left.data(), bytes.data() + sizeof(header), count * sizeof(T));
+        std::memcpy(right.data(), bytes.data() + sizeof(header) + count * sizeof(T), count * sizeof(T));
+        return CachedLists<T>{NumberLists<T>(std::move(left), std::move(right)), (header.flags & CACHE_SORTED) != 0};
+    } catch (const std::exception &) {
+        return std::unexpected(aoc::exceptions::AlgorithmError("Failed to allocate cached lists"));
+    }
+}
+
+inline std::filesystem::path Day01::cachePathFor(const std::filesystem::path &textPath) {
+    auto path = textPath;
+    path.replace_extension(".bin");
+    return path;
+}
+
+template<aoc::templates::Numeric T, typename Consumer>
+std::expected<void, aoc::exceptions::AocException> Day01::forEachPair(std::istream &stream,
+                                                                      Consumer &&consumer) noexcept {
     T num1;
     T num2;
 
-    //Directly read the two numbers into the vectors
+    //Directly read the two numbers into the consumer
     try {
         while (true) {
-            if (!(stream.value() >> num1)) {
+            if (!(stream >> num1)) {
                 // End of file is OK, other failures are errors
-                if (!stream.value().eof()) {
+                if (!stream.eof()) {
                     return std::unexpected(aoc::exceptions::DataFormatError("Stream in invalid state"));
                 }
                 break;
             }
             // If we got num1 but can't get num2, that's an error
-            if (!(stream.value() >> num2)) {
+            if (!(stream >> num2)) {
                 return std::unexpected(aoc::exceptions::DataFormatError("Stream in invalid state"));
             }
-            listOne.push_back(num1);
-            listTwo.push_back(num2);
+            if (auto consumed = consumer(num1, num2); !consumed) {
+                return std::unexpected(consumed.error());
+            }
         }
     } catch (const std::bad_expected_access<T>&) {
         return std::unexpected(aoc::exceptions::DataFormatError("Stream in invalid state"));
@@ -142,13 +1165,7 @@ std::expected<Day01::NumberLists<T>, aoc::exceptions::AocException> Day01::readL
         return std::unexpected(aoc::exceptions::DataFormatError("Error reading numbers"));
     }
 
-    //If the vectors are not equal, something went wrong reading the data
-    if (listOne.size() != listTwo.size()) {
-        return std::unexpected(aoc::exceptions::DataFormatError(
-            std::format("vectors are not equal: {} != {}", listOne.size(), listTwo.size())));
-    }
-
-    return NumberLists<T>(std::move(listOne), std::move(listTwo));
+    return {};
 }
 
 inline std::expected<std::ifstream, aoc::exceptions::AocException> Day01::openFile(
@@ -1,56 +1,246 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <expected>
 #include <execution>
 #include <filesystem>
 #include <fstream>
+#include <limits>
 #include <print>
 #include <ranges>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 #include <boost/container/small_vector.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 #include "AocExceptions.h"
 #include "AocTemplates.h"
+#include "CheckedMath.h"
+#include "FlatLists.h"
 
 class Day02 {
 public:
     Day02() = delete; // This class is not meant to be instantiated
     ~Day02() = delete; // No inheritance either
 
+    enum class Monotonicity { Increasing, Decreasing, Either };
+
+    // Every step moves by MinStep..MaxStep (inclusive) in one direction allowed by Mode. The checks below take
+    // the policy as a template parameter, so each rule variant is its own instantiation with constant bounds.
+    template<int64_t MinStep, int64_t MaxStep, Monotonicity Mode = Monotonicity::Either>
+    struct SafetyPolicy {
+        static_assert(0 <= MinStep && MinStep <= MaxStep, "Steps are distances in the chosen direction");
+
+        static constexpr int64_t MIN_STEP = MinStep;
+        static constexpr int64_t MAX_STEP = MaxStep;
+        static constexpr bool ALLOWS_INCREASING = Mode != Monotonicity::Decreasing;
+        static constexpr bool ALLOWS_DECREASING = Mode != Monotonicity::Increasing;
+
+        template<bool Increasing, aoc::templates::Numeric T>
+        [[nodiscard]] static constexpr bool validStep(const T from, const T to) noexcept {
+            const T diff = Increasing ? to - from : from - to;
+            return diff >= static_cast<T>(MinStep) && diff <= static_cast<T>(MaxStep);
+        }
+    };
+
+    // Steps of 1 to 3, all increasing or all decreasing
+    using PuzzleRules = SafetyPolicy<1, 3>;
+
     static void partOne();
 
     static void partTwoBruteForce();
 
     static void partTwoSmart();
 
+    static void partTwoLinear();
+
+    static void partTwoWithTolerance(size_t maxRemovals);
+
+    // Both counts from one pass over the file in fixed size blocks, memory use does not depend on its size
+    static void bothPartsStreaming();
+
 #ifdef TESTING
     friend class Day02Test;
 #endif
+#ifdef BENCHMARKING
+    friend class Day02Bench;
+#endif
 
 private:
+    // Same answer as isSafe, but countSafeParallel recognises it and evaluates BATCH_LANES integer reports at once
+    template<typename Policy = PuzzleRules>
+    struct BatchedSafe {
+        using Rules = Policy;
+
+        template<aoc::templates::Numeric T>
+        bool operator()(std::span<const T> list) const noexcept { return isSafe<T, Policy>(list); }
+    };
+
+    template<typename Op>
+    static constexpr bool isBatched() noexcept {
+        if constexpr (requires { typename Op::Rules; }) {
+            return std::same_as<Op, BatchedSafe<typename Op::Rules> >;
+        } else {
+            return false;
+        }
+    }
+
+    // Reports per batch: one int8 lane each in a 256-bit register
+    static constexpr size_t BATCH_LANES = 32;
+
+    // Decides "safe" and "safe after removing at most one level" while levels arrive one at a time,
+    // in O(1) time per level and without storing the report
+    template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy = PuzzleRules>
+    class ToleranceState {
+    public:
+        void push(T value) noexcept;
+
+        [[nodiscard]] bool safe() const noexcept;
+
+        [[nodiscard]] bool safeWithOneRemoval() const noexcept;
+
+        [[nodiscard]] size_t size() const noexcept;
+
+        void reset() noexcept;
+
+    private:
+        // What is still possible for one direction, given the levels pushed so far
+        struct Direction {
+            bool clean = true; // Nothing removed, every step valid
+            bool removedEarlier = false; // One level removed before the last one, which is kept
+            bool skippedLast = false; // The last level is the removed one
+        };
+
+        template<bool Increasing>
+        void advance(Direction &direction, T value) const noexcept;
+
+        Direction increasing{Policy::ALLOWS_INCREASING};
+        Direction decreasing{Policy::ALLOWS_DECREASING};
+        T last{};
+        T beforeLast{};
+        size_t count = 0;
+    };
+
+    struct StreamCounts {
+        size_t safe = 0;
+        size_t safeWithOneRemoval = 0;
+    };
+
+    // Byte level automaton: digits are accumulated straight into the level being read, each finished level
+    // goes into a ToleranceState and each line end tallies the report. Blocks may split anywhere.
+    template<std::integral T, aoc::templates::StepPolicy<T> Policy = PuzzleRules>
+    class ReportScanner {
+    public:
+        std::expected<void, aoc::exceptions::AocException> feed(std::string_view bytes) noexcept;
+
+        std::expected<StreamCounts, aoc::exceptions::AocException> finish() noexcept;
+
+    private:
+        [[nodiscard]] bool endLevel() noexcept;
+
+        void endReport() noexcept;
+
+        ToleranceState<T, Policy> report;
+        StreamCounts counts;
+        T value{0};
+        bool inLevel = false;
+        bool negative = false;
+        bool signOnly = false; // A '-' with no digits after it yet
+    };
+
+    static constexpr size_t STREAM_BLOCK_SIZE = size_t{1} << 16;
+
     template<aoc::templates::Numeric T, aoc::templates::VectorOperation<T> Op>
-    static size_t countSafeParallel(const std::vector<std::vector<T> > &lines, Op op);
+    static size_t countSafeParallel(const aoc::FlatLists<T> &lines, Op op);
 
-    template<aoc::templates::Numeric T>
+    template<std::integral T, aoc::templates::StepPolicy<T> Policy>
+    static size_t countSafeBatched(const aoc::FlatLists<T> &lines);
+
+    // Bit i is set if report first + i is safe. Step j of every report is transposed into lane i, and the
+    // diffs of all lanes are taken, checked and clamped to [-(MAX_STEP + 1), MAX_STEP + 1] in vectors
+    template<std::integral T, aoc::templates::StepPolicy<T> Policy = PuzzleRules>
+    [[nodiscard]] static uint32_t safetyMask(const aoc::FlatLists<T> &lines, size_t first) noexcept;
+
+    // Transposed levels in a signed type, so diffs never depend on unsigned wraparound
+    template<std::integral T>
+    using BatchLevel = std::conditional_t<sizeof(T) <= sizeof(int32_t), int32_t, int64_t>;
+
+    // Unsigned levels are offset by the sign bit: order and differences stay, the range becomes signed
+    template<std::integral T>
+    [[nodiscard]] static constexpr BatchLevel<T> toBatchLevel(T value) noexcept;
+
+#if defined(__AVX2__)
+    using DiffVector = __m256i;
+#else
+    using DiffVector = std::array<int8_t, BATCH_LANES>;
+#endif
+
+    // current - previous per lane, saturated to +-(MAX_STEP + 1) including diffs that overflow Level
+    template<typename Policy, typename Level>
+    [[nodiscard]] static DiffVector clampedDiffs(const std::array<Level, BATCH_LANES> &previous,
+                                                 const std::array<Level, BATCH_LANES> &current) noexcept;
+
+    // Lanes whose diff is a valid increasing / decreasing step
+    template<typename Policy>
+    [[nodiscard]] static std::pair<uint32_t, uint32_t> stepMasks(DiffVector diffs) noexcept;
+
+    template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy = PuzzleRules>
     [[nodiscard]] static bool rotateAndCheckSafety(std::vector<T> &testVec, std::span<const T> list, size_t i);
 
-    template<aoc::templates::Numeric T>
+    template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy = PuzzleRules>
     [[nodiscard]] static bool isSafeWithChance(std::span<const T> list);
 
-    template<aoc::templates::Numeric T>
+    template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy = PuzzleRules>
     [[nodiscard]] static bool canBeMadeSafe(std::span<const T> list);
 
+    // Single pass, no allocation and no copy of the report; same answers as the two checks above
+    template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy = PuzzleRules>
+    [[nodiscard]] static bool canBeMadeSafeLinear(std::span<const T> list) noexcept;
+
+    // Safe after removing at most K levels, O(n * K) time and O(K) memory
+    template<aoc::templates::Numeric T, size_t K, aoc::templates::StepPolicy<T> Policy = PuzzleRules>
+    [[nodiscard]] static bool canBeMadeSafeUpTo(std::span<const T> list) noexcept;
+
+    template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy = PuzzleRules>
+    [[nodiscard]] static bool canBeMadeSafeUpTo(std::span<const T> list, size_t maxRemovals);
+
+    // Tries every set of up to maxRemovals removed levels, reference for the DP above
+    template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy = PuzzleRules>
+    [[nodiscard]] static bool isSafeWithChances(std::span<const T> list, size_t maxRemovals);
+
+    // Fewest removals leaving a valid chain in one direction, capped at maxRemovals + 1.
+    // best[i] (kept in a ring of maxRemovals + 2 slots) is the fewest removals with level i kept last.
+    template<bool Increasing, aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
+    [[nodiscard]] static size_t minimumRemovals(std::span<const T> list, size_t maxRemovals,
+                                                std::span<size_t> ring) noexcept;
+
+    // Index of the first step breaking the rules in this direction; list.size() - 1 when every step is
+    // valid and list.size() when the direction is not allowed at all
+    template<bool Increasing, aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
+    [[nodiscard]] static size_t firstInvalidStep(std::span<const T> list) noexcept;
+
     static std::expected<std::ifstream, aoc::exceptions::AocException> openFile(
         const std::filesystem::path &path) noexcept;
 
     template<aoc::templates::Numeric T>
-    static std::expected<std::vector<std::vector<T> >, aoc::exceptions::AocException> readLists(
+    static std::expected<aoc::FlatLists<T>, aoc::exceptions::AocException> readLists(
         const std::filesystem::path &path) noexcept;
 
-    template<aoc::templates::Numeric T>
+    template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy = PuzzleRules>
     [[nodiscard]] static bool isSafe(std::span<const T> list);
 
+    template<std::integral T, aoc::templates::StepPolicy<T> Policy = PuzzleRules>
+    static std::expected<StreamCounts, aoc::exceptions::AocException> scanReports(std::istream &stream) noexcept;
+
     static inline std::filesystem::path INPUT_FILE{std::filesystem::path{"../data"} / "d2p1.txt"};
 };
 
@@ -61,11 +251,7 @@ inline void Day02::partOne() {
         return;
     }
 
-    size_t safeNum = 0;
-
-    for (auto line: lines.value()) {
-        if (isSafe<int64_t>(line)) safeNum++;
-    }
+    const size_t safeNum = countSafeParallel(lines.value(), BatchedSafe<>{});
 
     std::println("Number of safe lines: {}", safeNum);
 }
@@ -94,25 +280,330 @@ inline void Day02::partTwoSmart() {
     std::println("Number of safe lines (smart): {}", safeNum);
 }
 
+inline void Day02::partTwoLinear() {
+    auto lines = readLists<int64_t>(INPUT_FILE);
+    if (!lines) {
+        std::println("Error reading lists: {}", lines.error().what());
+        return;
+    }
+
+    const size_t safeNum = countSafeParallel(lines.value(), canBeMadeSafeLinear<int64_t>);
+
+    std::println("Number of safe lines (linear): {}", safeNum);
+}
+
+inline void Day02::partTwoWithTolerance(const size_t maxRemovals) {
+    auto lines = readLists<int64_t>(INPUT_FILE);
+    if (!lines) {
+        std::println("Error reading lists: {}", lines.error().what());
+        return;
+    }
+
+    const size_t safeNum = countSafeParallel(lines.value(), [maxRemovals](std::span<const int64_t> list) {
+        return canBeMadeSafeUpTo<int64_t>(list, maxRemovals);
+    });
+
+    std::println("Number of safe lines (up to {} removals): {}", maxRemovals, safeNum);
+}
+
+inline void Day02::bothPartsStreaming() {
+    auto stream = openFile(INPUT_FILE);
+    if (!stream) {
+        std::println("Error reading lists: {}", stream.error().what());
+        return;
+    }
+
+    const auto counts = scanReports<int64_t>(stream.value());
+    if (!counts) {
+        std::println("Error reading lists: {}", counts.error().what());
+        return;
+    }
+
+    std::println("Number of safe lines: {}, with one removal: {} (streaming)", counts->safe,
+                 counts->safeWithOneRemoval);
+}
+
+template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
+void Day02::ToleranceState<T, Policy>::push(const T value) noexcept {
+    advance<true>(increasing, value);
+    advance<false>(decreasing, value);
+    beforeLast = last;
+    last = value;
+    ++count;
+}
+
+template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
+bool Day02::ToleranceState<T, Policy>::safe() const noexcept { return increasing.clean || decreasing.clean; }
+
+template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
+bool Day02::ToleranceState<T, Policy>::safeWithOneRemoval() const noexcept {
+    const auto possible = [](const Direction &d) { return d.clean || d.removedEarlier || d.skippedLast; };
+    return possible(increasing) || possible(decreasing);
+}
+
+template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
+size_t Day02::ToleranceState<T, Policy>::size() const noexcept { return count; }
+
+template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
+void Day02::ToleranceState<T, Policy>::reset() noexcept { *this = ToleranceState{}; }
+
+template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
+template<bool Increasing>
+void Day02::ToleranceState<T, Policy>::advance(Direction &direction, const T value) const noexcept {
+    // After a skip the last kept level is beforeLast, or nothing when the very first level was skipped
+    const Direction next{
+        direction.clean && (count == 0 || Policy::template validStep<Increasing>(last, value)),
+        (direction.removedEarlier && Policy::template validStep<Increasing>(last, value)) ||
+        (direction.skippedLast && (count < 2 || Policy::template validStep<Increasing>(beforeLast, value))),
+        direction.clean
+    };
+    direction = next;
+}
+
+template<std::integral T, aoc::templates::StepPolicy<T> Policy>
+std::expected<void, aoc::exceptions::AocException> Day02::ReportScanner<T, Policy>::feed(
+    const std::string_view bytes) noexcept {
+    for (const char c: bytes) {
+        if (c >= '0' && c <= '9') {
+            // Accumulate towards the sign so the most negative value still fits
+            constexpr T UPPER = std::numeric_limits<T>::max() / 10;
+            constexpr T LOWER = std::numeric_limits<T>::min() / 10;
+            const T digit = static_cast<T>(c - '0');
+            const bool overflow = negative
+                                      ? value < LOWER || (value == LOWER && -digit < std::numeric_limits<T>::min() % 10)
+                                      : value > UPPER || (value == UPPER && digit > std::numeric_limits<T>::max() % 10);
+            if (overflow) [[unlikely]] {
+                return std::unexpected(aoc::exceptions::DataFormatError("Invalid number format"));
+            }
+            value = static_cast<T>(value * 10 + (negative ? -digit : digit));
+            inLevel = true;
+            signOnly = false;
+        } else if (c == '-' && !inLevel && !signOnly && std::is_signed_v<T>) {
+            negative = true;
+            signOnly = true;
+        } else if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            if (!endLevel()) {
+                return std::unexpected(aoc::exceptions::DataFormatError("Invalid number format"));
+            }
+            if (c == '\n') endReport();
+        } else {
+            return std::unexpected(aoc::exceptions::DataFormatError("Invalid number format"));
+        }
+    }
+    return {};
+}
+
+template<std::integral T, aoc::templates::StepPolicy<T> Policy>
+std::expected<Day02::StreamCounts, aoc::exceptions::AocException> Day02::ReportScanner<T, Policy>::finish() noexcept {
+    // The last line does not need a line end
+    if (!endLevel()) {
+        return std::unexpected(aoc::exceptions::DataFormatError("Invalid number format"));
+    }
+    endReport();
+    return counts;
+}
+
+template<std::integral T, aoc::templates::StepPolicy<T> Policy>
+bool Day02::ReportScanner<T, Policy>::endLevel() noexcept {
+    if (signOnly) return false;
+    if (inLevel) {
+        report.push(value);
+        value = T{0};
+        inLevel = false;
+        negative = false;
+    }
+    return true;
+}
+
+template<std::integral T, aoc::templates::StepPolicy<T> Policy>
+void Day02::ReportScanner<T, Policy>::endReport() noexcept {
+    // Blank lines are not reports, same as readLists
+    if (report.size() == 0) return;
+    counts.safe += report.safe() ? 1 : 0;
+    counts.safeWithOneRemoval += report.safeWithOneRemoval() ? 1 : 0;
+    report.reset();
+}
+
 template<aoc::templates::Numeric T, aoc::templates::VectorOperation<T> Op>
-size_t Day02::countSafeParallel(const std::vector<std::vector<T> > &lines, Op op) {
-    return std::transform_reduce(
-        std::execution::par_unseq,
-        lines.begin(), lines.end(),
+size_t Day02::countSafeParallel(const aoc::FlatLists<T> &lines, Op op) {
+    if constexpr (isBatched<Op>() && std::integral<T>) {
+        return countSafeBatched<T, typename Op::Rules>(lines);
+    } else {
+        // Adjacent offsets delimit each report, so workers walk two plain arrays
+        const auto offsets = lines.offsets();
+        const auto values = lines.values();
+        return std::transform_reduce(
+            std::execution::par_unseq,
+            offsets.begin(), offsets.end() - 1, // Report starts
+            offsets.begin() + 1, // Report ends
+            size_t{0},
+            std::plus{},
+            [op, values](const size_t begin, const size_t end) -> size_t {
+                return op(values.subspan(begin, end - begin)) ? 1 : 0;
+            }
+        );
+    }
+}
+
+template<std::integral T, aoc::templates::StepPolicy<T> Policy>
+size_t Day02::countSafeBatched(const aoc::FlatLists<T> &lines) {
+    const size_t batches = (lines.size() + BATCH_LANES - 1) / BATCH_LANES;
+    return tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, batches),
         size_t{0},
-        std::plus{},
-        [op](const auto &line) {
-            return op(std::span{line}) ? 1 : 0;
-        }
+        [&lines](const auto &range, size_t safe) {
+            for (size_t batch = range.begin(); batch != range.end(); ++batch) {
+                safe += static_cast<size_t>(std::popcount(safetyMask<T, Policy>(lines, batch * BATCH_LANES)));
+            }
+            return safe;
+        },
+        std::plus{}
     );
 }
 
-template<aoc::templates::Numeric T>
+template<std::integral T, aoc::templates::StepPolicy<T> Policy>
+uint32_t Day02::safetyMask(const aoc::FlatLists<T> &lines, const size_t first) noexcept {
+    const size_t lanes = std::min(BATCH_LANES, lines.size() - first);
+    const auto offsets = lines.offsets();
+    const auto values = lines.values();
+
+    // Two rows of transposed levels, swapped every step; lanes without levels stay at zero
+    std::array<std::array<BatchLevel<T>, BATCH_LANES>, 2> levels{};
+    std::array<size_t, BATCH_LANES> begins{};
+    std::array<size_t, BATCH_LANES> steps{};
+    size_t longest = 0;
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        begins[lane] = offsets[first + lane];
+        steps[lane] = std::max<size_t>(offsets[first + lane + 1] - begins[lane], 1) - 1;
+        longest = std::max(longest, steps[lane]);
+        if (offsets[first + lane + 1] > begins[lane]) levels[0][lane] = toBatchLevel(values[begins[lane]]);
+    }
+
+    static_assert(Policy::MAX_STEP < std::numeric_limits<int8_t>::max(), "Steps must fit an int8 lane");
+    uint32_t increasing = Policy::ALLOWS_INCREASING ? ~uint32_t{0} : 0;
+    uint32_t decreasing = Policy::ALLOWS_DECREASING ? ~uint32_t{0} : 0;
+    for (size_t step = 0; step < longest; ++step) {
+        const auto &previous = levels[step % 2];
+        auto &current = levels[(step + 1) % 2];
+        // Lanes past the end of their report repeat their last level, a zero diff outside active
+        uint32_t active = 0;
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            if (step < steps[lane]) {
+                current[lane] = toBatchLevel(values[begins[lane] + step + 1]);
+                active |= uint32_t{1} << lane;
+            } else {
+                current[lane] = previous[lane];
+            }
+        }
+        const auto [up, down] = stepMasks<Policy>(clampedDiffs<Policy>(previous, current));
+        increasing &= up | ~active;
+        decreasing &= down | ~active;
+    }
+
+    const uint32_t used = lanes == BATCH_LANES ? ~uint32_t{0} : (uint32_t{1} << lanes) - 1;
+    return (increasing | decreasing) & used;
+}
+
+template<std::integral T>
+constexpr Day02::BatchLevel<T> Day02::toBatchLevel(const T value) noexcept {
+    using Level = BatchLevel<T>;
+    if constexpr (std::signed_integral<T>) {
+        return static_cast<Level>(value);
+    } else {
+        using Unsigned = std::make_unsigned_t<Level>;
+        return static_cast<Level>(static_cast<Unsigned>(value) ^ (Unsigned{1} << (sizeof(Level) * 8 - 1)));
+    }
+}
+
+template<typename Policy, typename Level>
+Day02::DiffVector Day02::clampedDiffs(const std::array<Level, BATCH_LANES> &previous,
+                                      const std::array<Level, BATCH_LANES> &current) noexcept {
+    constexpr auto BOUND = static_cast<Level>(Policy::MAX_STEP + 1); // Invalid either way, like anything beyond it
+#if defined(__AVX2__)
+    constexpr bool WIDE = sizeof(Level) == sizeof(int64_t);
+    const auto set1 = [](const Level value) {
+        if constexpr (WIDE) return _mm256_set1_epi64x(value); else return _mm256_set1_epi32(value);
+    };
+    const auto greater = [](const __m256i a, const __m256i b) {
+        if constexpr (WIDE) return _mm256_cmpgt_epi64(a, b); else return _mm256_cmpgt_epi32(a, b);
+    };
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i upper = set1(BOUND);
+    const __m256i lower = set1(static_cast<Level>(-BOUND));
+    // Diffs of the 32 / sizeof(Level) lanes starting at lane
+    const auto diffsAt = [&](const size_t lane) {
+        const __m256i before = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(previous.data() + lane));
+        const __m256i after = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(current.data() + lane));
+        __m256i diff;
+        if constexpr (WIDE) diff = _mm256_sub_epi64(after, before); else diff = _mm256_sub_epi32(after, before);
+        // Wrapped iff the operands differ in sign and the result does not have after's sign; the true diff
+        // is then far out of range with after's sign
+        const __m256i wrapped = greater(zero, _mm256_and_si256(_mm256_xor_si256(after, before),
+                                                                _mm256_xor_si256(after, diff)));
+        diff = _mm256_blendv_epi8(diff, upper, greater(diff, upper));
+        diff = _mm256_blendv_epi8(diff, lower, greater(lower, diff));
+        return _mm256_blendv_epi8(diff, _mm256_blendv_epi8(upper, lower, greater(zero, after)), wrapped);
+    };
+
+    // Four vectors of eight int32 diffs each, lanes 0-7, 8-15, 16-23, 24-31
+    __m256i dwords[4];
+    for (size_t part = 0; part < 4; ++part) {
+        if constexpr (WIDE) {
+            // Clamped diffs fit their low dword: gather those of two vectors into one
+            const __m256i lowDwords = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+            const __m256i first = _mm256_permutevar8x32_epi32(diffsAt(part * 8), lowDwords);
+            const __m256i second = _mm256_permutevar8x32_epi32(diffsAt(part * 8 + 4), lowDwords);
+            dwords[part] = _mm256_permute2x128_si256(first, second, 0x20);
+        } else {
+            dwords[part] = diffsAt(part * 8);
+        }
+    }
+    // The packs interleave 128-bit halves, leaving 4-lane groups in the order 0 2 4 6 1 3 5 7
+    const __m256i words = _mm256_packs_epi32(dwords[0], dwords[1]);
+    const __m256i moreWords = _mm256_packs_epi32(dwords[2], dwords[3]);
+    return _mm256_permutevar8x32_epi32(_mm256_packs_epi16(words, moreWords),
+                                       _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+#else
+    DiffVector diffs{};
+    for (size_t lane = 0; lane < BATCH_LANES; ++lane) {
+        // A diff that overflows Level is far out of range, with current's sign
+        const auto diff = aoc::checked::sub(current[lane], previous[lane]);
+        const Level saturated = current[lane] < 0 ? static_cast<Level>(-BOUND) : BOUND;
+        diffs[lane] = static_cast<int8_t>(diff ? std::clamp<Level>(*diff, -BOUND, BOUND) : saturated);
+    }
+    return diffs;
+#endif
+}
+
+template<typename Policy>
+std::pair<uint32_t, uint32_t> Day02::stepMasks(const DiffVector diffs) noexcept {
+    // Valid increasing steps are MIN_STEP - 1 < d < MAX_STEP + 1, decreasing ones the mirror image
+    constexpr auto BELOW = static_cast<int8_t>(Policy::MIN_STEP - 1);
+    constexpr auto ABOVE = static_cast<int8_t>(Policy::MAX_STEP + 1);
+#if defined(__AVX2__)
+    const __m256i d = diffs;
+    const __m256i up = _mm256_and_si256(_mm256_cmpgt_epi8(d, _mm256_set1_epi8(BELOW)),
+                                        _mm256_cmpgt_epi8(_mm256_set1_epi8(ABOVE), d));
+    const __m256i down = _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<int8_t>(-BELOW)), d),
+                                          _mm256_cmpgt_epi8(d, _mm256_set1_epi8(static_cast<int8_t>(-ABOVE))));
+    return {static_cast<uint32_t>(_mm256_movemask_epi8(up)), static_cast<uint32_t>(_mm256_movemask_epi8(down))};
+#else
+    uint32_t up = 0;
+    uint32_t down = 0;
+    for (size_t lane = 0; lane < BATCH_LANES; ++lane) {
+        up |= static_cast<uint32_t>(diffs[lane] > BELOW && diffs[lane] < ABOVE) << lane;
+        down |= static_cast<uint32_t>(diffs[lane] < -BELOW && diffs[lane] > -ABOVE) << lane;
+    }
+    return {up, down};
+#endif
+}
+
+template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
 bool Day02::rotateAndCheckSafety(std::vector<T> &testVec, std::span<const T> list, size_t i) {
     std::ranges::rotate(testVec.begin() + i, testVec.begin() + i + 1, testVec.end());
     testVec.pop_back();
 
-    if (isSafe<T>(testVec)) {
+    if (isSafe<T, Policy>(testVec)) {
         return true;
     }
 
@@ -121,13 +612,13 @@ bool Day02::rotateAndCheckSafety(std::vector<T> &testVec, std::span<const T> lis
     return false;
 }
 
-template<aoc::templates::Numeric T>
+template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
 bool Day02::isSafeWithChance(std::span<const T> list) {
     if (list.size() < 2) return true;
-    if (isSafe<T>(list)) return true;
+    if (isSafe<T, Policy>(list)) return true;
     std::vector<T> testVec = list | std::ranges::to<std::vector>();
     for (uint32_t i = 0; i < list.size(); i++) {
-        if (rotateAndCheckSafety(testVec, list, i)) {
+        if (rotateAndCheckSafety<T, Policy>(testVec, list, i)) {
             return true;
         }
     }
@@ -135,28 +626,16 @@ bool Day02::isSafeWithChance(std::span<const T> list) {
     return false;
 }
 
-template<aoc::templates::Numeric T>
+template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
 bool Day02::canBeMadeSafe(std::span<const T> list) {
     if (list.size() < 2) return true;
-    if (isSafe<T>(list)) return true;
-
-    boost::container::small_vector<size_t, 10> problematicPositions;
+    if (isSafe<T, Policy>(list)) return true;
 
-    // Check for direction changes using adjacent triplets
-    for (const auto &[a, b, c]: std::views::adjacent<3>(list)) {
-        T curr_diff = b - a;
-        T next_diff = c - b;
-        if (curr_diff * next_diff <= 0) {
-            size_t i = &a - list.data(); // Get position
-            problematicPositions.insert(problematicPositions.end(), {i, i + 1, i + 2});
-        }
-    }
-
-    // Check for invalid differences between pairs
-    for (const auto &[a, b]: std::views::adjacent<2>(list)) {
-        T curr_diff = b - a;
-        if (std::abs(curr_diff) > 3 || curr_diff == 0) {
-            size_t i = &a - list.data();
+    // Removing a level only fixes a direction if it touches that direction's first invalid step,
+    // any other removal leaves that step in place
+    boost::container::small_vector<size_t, 4> problematicPositions;
+    for (const size_t i: {firstInvalidStep<true, T, Policy>(list), firstInvalidStep<false, T, Policy>(list)}) {
+        if (i + 1 < list.size()) {
             problematicPositions.insert(problematicPositions.end(), {i, i + 1});
         }
     }
@@ -170,7 +649,7 @@ bool Day02::canBeMadeSafe(std::span<const T> list) {
 
     std::vector<T> testVec = std::ranges::to<std::vector>(list);
     for (size_t pos: problematicPositions) {
-        if (rotateAndCheckSafety(testVec, list, pos)) {
+        if (rotateAndCheckSafety<T, Policy>(testVec, list, pos)) {
             return true;
         }
     }
@@ -178,6 +657,89 @@ bool Day02::canBeMadeSafe(std::span<const T> list) {
     return false;
 }
 
+template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
+bool Day02::canBeMadeSafeLinear(std::span<const T> list) noexcept {
+    ToleranceState<T, Policy> state;
+    for (const T value: list) {
+        state.push(value);
+    }
+    return state.safeWithOneRemoval();
+}
+
+template<aoc::templates::Numeric T, size_t K, aoc::templates::StepPolicy<T> Policy>
+bool Day02::canBeMadeSafeUpTo(std::span<const T> list) noexcept {
+    std::array<size_t, K + 2> ring{};
+    return minimumRemovals<true, T, Policy>(list, K, ring) <= K ||
+           minimumRemovals<false, T, Policy>(list, K, ring) <= K;
+}
+
+template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
+bool Day02::canBeMadeSafeUpTo(std::span<const T> list, size_t maxRemovals) {
+    // Removing every level is always enough, so larger budgets behave the same
+    maxRemovals = std::min(maxRemovals, list.size());
+    boost::container::small_vector<size_t, 16> slots(maxRemovals + 2);
+    const std::span<size_t> ring{slots.data(), slots.size()};
+    return minimumRemovals<true, T, Policy>(list, maxRemovals, ring) <= maxRemovals ||
+           minimumRemovals<false, T, Policy>(list, maxRemovals, ring) <= maxRemovals;
+}
+
+template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
+bool Day02::isSafeWithChances(std::span<const T> list, const size_t maxRemovals) {
+    // Removed positions only ever increase, so every subset is tried once
+    const auto search = [](const auto &self, std::span<const T> levels, const size_t budget, const size_t start) {
+        if (isSafe<T, Policy>(levels)) return true;
+        if (budget == 0) return false;
+        std::vector<T> reduced(levels.size() - 1);
+        for (size_t i = start; i < levels.size(); ++i) {
+            std::copy(levels.begin(), levels.begin() + static_cast<std::ptrdiff_t>(i), reduced.begin());
+            std::copy(levels.begin() + static_cast<std::ptrdiff_t>(i) + 1, levels.end(),
+                      reduced.begin() + static_cast<std::ptrdiff_t>(i));
+            if (self(self, std::span<const T>{reduced}, budget - 1, i)) return true;
+        }
+        return false;
+    };
+    return search(search, list, maxRemovals, 0);
+}
+
+template<bool Increasing, aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
+size_t Day02::minimumRemovals(std::span<const T> list, const size_t maxRemovals, std::span<size_t> ring) noexcept {
+    if constexpr (!(Increasing ? Policy::ALLOWS_INCREASING : Policy::ALLOWS_DECREASING)) {
+        return maxRemovals + 1;
+    }
+    const size_t n = list.size();
+    const size_t slots = ring.size();
+    const size_t impossible = maxRemovals + 1;
+    size_t answer = std::min(n, impossible); // Removing everything
+
+    for (size_t i = 0; i < n; ++i) {
+        size_t best = std::min(i, impossible); // Everything before i removed
+        // Only predecessors with at most maxRemovals levels skipped in between can help
+        const size_t earliest = i > maxRemovals + 1 ? i - maxRemovals - 1 : 0;
+        for (size_t j = earliest; j < i; ++j) {
+            if (Policy::template validStep<Increasing>(list[j], list[i])) {
+                best = std::min(best, ring[j % slots] + (i - j - 1));
+            }
+        }
+        ring[i % slots] = std::min(best, impossible);
+        if (const size_t after = n - 1 - i; after <= maxRemovals) {
+            answer = std::min(answer, best + after);
+        }
+    }
+    return std::min(answer, impossible);
+}
+
+template<bool Increasing, aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
+size_t Day02::firstInvalidStep(std::span<const T> list) noexcept {
+    if constexpr (!(Increasing ? Policy::ALLOWS_INCREASING : Policy::ALLOWS_DECREASING)) {
+        return list.size();
+    }
+    size_t i = 0;
+    while (i + 1 < list.size() && Policy::template validStep<Increasing>(list[i], list[i + 1])) {
+        ++i;
+    }
+    return i;
+}
+
 inline std::expected<std::ifstream, aoc::exceptions::AocException> Day02::openFile(
     const std::filesystem::path &path) noexcept {
     if (!exists(path)) {
@@ -191,18 +753,18 @@ inline std::expected<std::ifstream, aoc::exceptions::AocException> Day02::openFi
 }
 
 template<aoc::templates::Numeric T>
-std::expected<std::vector<std::vector<T> >, aoc::exceptions::AocException> Day02::readLists(
+std::expected<aoc::FlatLists<T>, aoc::exceptions::AocException> Day02::readLists(
     const std::filesystem::path &path) noexcept {
     auto stream = openFile(path);
     if (!stream) {
         return std::unexpected(stream.error());
     }
-    std::vector<std::vector<T> > allLines;
+    aoc::FlatLists<T> allLines;
 
     try {
         std::string line;
         while (std::getline(stream.value(), line)) {
-            std::vector<T> numbers;
+            size_t numbers = 0;
             auto view = std::string_view{line} | std::views::split(' ')
                         | std::views::filter([](auto v) { return !std::ranges::empty(v); });
 
@@ -213,11 +775,12 @@ std::expected<std::vector<std::vector<T> >, aoc::exceptions::AocException> Day02
                 if (ec != std::errc{}) {
                     return std::unexpected(aoc::exceptions::DataFormatError("Invalid number format"));
                 }
-                numbers.push_back(value);
+                allLines.push(value);
+                ++numbers;
             }
 
-            if (!numbers.empty()) {
-                allLines.push_back(std::move(numbers));
+            if (numbers != 0) {
+                allLines.endRow();
             }
         }
     } catch (const std::bad_expected_access<T> &) {
@@ -231,19 +794,38 @@ std::expected<std::vector<std::vector<T> >, aoc::exceptions::AocException> Day02
     return allLines;
 }
 
-template<aoc::templates::Numeric T>
+template<std::integral T, aoc::templates::StepPolicy<T> Policy>
+std::expected<Day02::StreamCounts, aoc::exceptions::AocException> Day02::scanReports(std::istream &stream) noexcept {
+    ReportScanner<T, Policy> scanner;
+    std::array<char, STREAM_BLOCK_SIZE> block{};
+    try {
+        while (stream) {
+            stream.read(block.data(), static_cast<std::streamsize>(block.size()));
+            const auto bytes = static_cast<size_t>(stream.gcount());
+            if (auto fed = scanner.feed(std::string_view{block.data(), bytes}); !fed) {
+                return std::unexpected(fed.error());
+            }
+        }
+        if (!stream.eof()) {
+            return std::unexpected(aoc::exceptions::DataFormatError("Stream in invalid state"));
+        }
+    } catch (const std::exception &) {
+        return std::unexpected(aoc::exceptions::DataFormatError("Error reading numbers"));
+    }
+    return scanner.finish();
+}
+
+template<aoc::templates::Numeric T, aoc::templates::StepPolicy<T> Policy>
 bool Day02::isSafe(std::span<const T> list) {
     if (list.size() < 2) return true;
 
-    bool isDecreasing = list[0] > list[1];
-    return std::ranges::all_of(
-        std::views::adjacent<2>(list),
-        [isDecreasing](const auto &pair) {
-            const auto [first, second] = pair;
-            T diff = second - first;
-            return diff != 0 &&
-                   std::abs(diff) < 4 &&
-                   (isDecreasing ? diff < 0 : diff > 0);
-        }
-    );
+    // Both directions are followed to the end instead of picking one from the first step,
+    // which keeps the loop free of data dependent branches and also covers policies allowing flat steps
+    bool increasing = Policy::ALLOWS_INCREASING;
+    bool decreasing = Policy::ALLOWS_DECREASING;
+    for (const auto &[first, second]: std::views::adjacent<2>(list)) {
+        increasing &= Policy::template validStep<true>(first, second);
+        decreasing &= Policy::template validStep<false>(first, second);
+    }
+    return increasing || decreasing;
 }
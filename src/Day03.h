@@ -1,5 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <execution>
 #include <expected>
 #include <filesystem>
 #include <fstream>
@@ -9,8 +14,17 @@
 #include <regex>
 #include <vector>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 #include "AocExceptions.h"
 #include "AocTemplates.h"
+#include "MappedFile.h"
+#include "Pattern.h"
 
 class Day03 {
 public:
@@ -21,60 +35,335 @@ public:
 
     static void partTwo();
 
+    // Both sums from the memory mapped file, scanned in parallel chunks
+    static void bothPartsParallel();
+
+    // Tokenises the input once, then answers every query from the token stream
+    static void allQueriesFromTokens();
+
+    // Push-style engine: bytes arrive in chunks of any size, split anywhere, and both running sums cover
+    // every instruction completed so far. Only the token in progress and the do()/don't() state are kept.
+    template<aoc::templates::Numeric T>
+    class StreamingSum {
+    public:
+        void feed(std::string_view bytes) noexcept;
+
+        [[nodiscard]] T sum() const noexcept;
+
+        [[nodiscard]] T enabledSum() const noexcept;
+
+    private:
+        // Bytes of the token read so far, e.g. DonT is "don't"
+        enum class State : uint8_t { Idle, M, Mu, Mul, Lhs, Rhs, D, Do, DoOpen, Don, DonQuote, DonT, DonTOpen };
+
+        void step(char c) noexcept;
+
+        void multiply(uint16_t left, uint16_t right) noexcept;
+
+        State state = State::Idle;
+        uint8_t digits = 0;
+        uint16_t lhs = 0;
+        uint16_t rhs = 0;
+        bool enabled = true;
+        T all{0};
+        T enabledOnly{0};
+    };
+
 #ifdef TESTING
     friend class Day03Test;
 #endif
+#ifdef BENCHMARKING
+    friend class Day03Bench;
+#endif
 
 private:
+    enum class Opcode : uint8_t { Mul, Do, Dont };
+
+    struct Instruction {
+        Opcode opcode = Opcode::Mul;
+        uint16_t lhs = 0; // Operands only for Mul, at most three digits each
+        uint16_t rhs = 0;
+    };
+
     using regexIterator = std::sregex_iterator;
     using matchResults = std::smatch;
 
+    using MulInstruction = aoc::pattern::Matcher<R"(mul(\d{1,3},\d{1,3}))">;
+    using DoInstruction = aoc::pattern::Matcher<R"(do())">;
+    using DontInstruction = aoc::pattern::Matcher<R"(don't())">;
+
     static inline const auto mulPattern = std::regex(R"(mul\((\d{1,3}),(\d{1,3})\))", std::regex::optimize);
     static inline const auto sectionPattern = std::regex(R"((do\(\)|^)([\s\S]*?)(don't\(\)|$))", std::regex::optimize);
 
     template<aoc::templates::Numeric T>
     static T stoT(std::string_view str) noexcept(false);
 
+    // Length of the instruction starting at text[pos], 0 if there is none. MulInstruction takes 1 to 3 digits
+    // followed directly by ',' or ')', exactly what mulPattern accepts.
+    static size_t matchInstruction(std::string_view text, size_t pos, Instruction &instruction) noexcept;
+
+    // Calls visit(instruction, offset) for every instruction in one forward pass, without allocating.
+    // Only offsets flagged by candidateMask are tried.
+    template<typename Visitor>
+    static void forEachInstruction(std::string_view text, Visitor &&visit);
+
+    static constexpr size_t PREFILTER_BLOCK = 64;
+
+    // Bit i is set if text[first + i] starts "mu" or "do", the only places an instruction can begin.
+    // Two 32 byte compares per pair of letters against the text and the text shifted by one.
+    [[nodiscard]] static uint64_t candidateMask(std::string_view text, size_t first) noexcept;
+
+    template <aoc::templates::Numeric T>
+    static T processMultiplications(std::string_view text) noexcept;
+
+    template <aoc::templates::Numeric T>
+    static T sumMultiplicationsDD(std::string_view input) noexcept;
+
+    // What a chunk does to the do()/don't() state: nothing, or the last toggle it contains
+    enum class Toggle : uint8_t { Keep, Enable, Disable };
+
+    // A chunk scanned without knowing whether it starts enabled: the enabled sum for both cases
+    template<aoc::templates::Numeric T>
+    struct ChunkSummary {
+        T all{0};
+        T whenEnabled{0};
+        T whenDisabled{0};
+        Toggle exit = Toggle::Keep;
+    };
+
+    // Longest instruction, "mul(123,456)"; a chunk reads this much past its end to finish the last one
+    static constexpr size_t MAX_INSTRUCTION = MulInstruction::MAX_LENGTH;
+
+    static constexpr size_t SCAN_CHUNK = size_t{1} << 20;
+
+    static constexpr size_t STREAM_BLOCK_SIZE = size_t{1} << 16;
+
+    // Instructions starting in text[begin, end). No instruction contains the start of another,
+    // so chunks need no knowledge of their neighbours beyond the overlap.
+    template<aoc::templates::Numeric T>
+    [[nodiscard]] static ChunkSummary<T> summarizeChunk(std::string_view text, size_t begin, size_t end) noexcept;
+
+    // left followed by right; associative, so chunks can be combined in any grouping as long as order is kept
+    template<aoc::templates::Numeric T>
+    [[nodiscard]] static ChunkSummary<T> combine(const ChunkSummary<T> &left, const ChunkSummary<T> &right) noexcept;
+
+    template<aoc::templates::Numeric T>
+    [[nodiscard]] static ChunkSummary<T> scanParallel(std::string_view text, size_t chunkSize = SCAN_CHUNK);
+
+    // Every instruction of a text as parallel arrays, so a query only streams the columns it needs.
+    // do() and don't() have zero operands, which lets products be summed without looking at opcodes.
+    struct TokenStream {
+        std::vector<Opcode> opcodes;
+        std::vector<uint16_t> lhs;
+        std::vector<uint16_t> rhs;
+        std::vector<uint64_t> offsets;
+
+        [[nodiscard]] size_t size() const noexcept { return opcodes.size(); }
+    };
+
+    // A run of instructions with the same do()/don't() state
+    struct Section {
+        bool enabled = true;
+        uint64_t offset = 0; // Of the toggle starting it, 0 for the first section
+        size_t multiplications = 0;
+
+        bool operator==(const Section &) const = default;
+    };
+
+    [[nodiscard]] static TokenStream tokenize(std::string_view text);
+
+    template<aoc::templates::Numeric T>
+    [[nodiscard]] static T sumAll(const TokenStream &tokens) noexcept;
+
+    template<aoc::templates::Numeric T>
+    [[nodiscard]] static T sumEnabled(const TokenStream &tokens) noexcept;
+
+    [[nodiscard]] static std::vector<Section> sections(const TokenStream &tokens);
+
+    // Original regex versions, kept as the reference for tests and benchmarks
     template <aoc::templates::Numeric T>
-    static T processMultiplications(std::string_view text);
+    static T processMultiplicationsRegex(std::string_view text);
 
     template <aoc::templates::Numeric T>
-    static T sumMultiplicationsDD(const std::string& input) noexcept;
+    static T sumMultiplicationsDDRegex(const std::string& input) noexcept;
 
     static inline std::expected<std::ifstream, aoc::exceptions::AocException> openFile(
     const std::filesystem::path &path) noexcept;
 
+    // Feeds the whole file through a StreamingSum in STREAM_BLOCK_SIZE reads
+    template<aoc::templates::Numeric T>
+    static std::expected<StreamingSum<T>, aoc::exceptions::AocException> streamFile(
+        const std::filesystem::path &path) noexcept;
+
     static inline std::filesystem::path INPUT_FILE{std::filesystem::path{"../data"} / "d3p1.txt"};
 };
 
 inline void Day03::partOne() {
-    auto file = openFile(INPUT_FILE);
-    if (!file) {
-        std::println("Error opening file: {}", file.error().what());
+    const auto result = streamFile<int64_t>(INPUT_FILE);
+    if (!result) {
+        std::println("Error opening file: {}", result.error().what());
         return;
     }
 
-    std::stringstream buffer;
-    buffer << file.value().rdbuf();
-    const std::string input = buffer.str();
-
-    const auto result = processMultiplications<int64_t>(input);
-    std::println("Sum of multiplications: {}", result);
+    std::println("Sum of multiplications: {}", result->sum());
 }
 
 inline void Day03::partTwo() {
-    auto file = openFile(INPUT_FILE);
-    if (!file) {
-        std::println("Error opening file: {}", file.error().what());
+    const auto result = streamFile<int64_t>(INPUT_FILE);
+    if (!result) {
+        std::println("Error opening file: {}", result.error().what());
         return;
     }
 
-    std::stringstream buffer;
-    buffer << file.value().rdbuf();
-    const std::string input = buffer.str();
+    std::println("Sum of multiplications: {}", result->enabledSum());
+}
 
-    const auto result = sumMultiplicationsDD<int64_t>(input);
-    std::println("Sum of multiplications: {}", result);
+template<aoc::templates::Numeric T>
+void Day03::StreamingSum<T>::feed(const std::string_view bytes) noexcept {
+    size_t i = 0;
+    // Finish the token carried over from the previous chunk
+    while (i < bytes.size() && state != State::Idle) {
+        step(bytes[i++]);
+    }
+
+    // Instructions starting this far from the end are complete, so the bulk goes through the prefiltered scanner.
+    // The automaton takes over at the limit even inside a matched instruction: the rest of one never holds
+    // an 'm' or 'd', so it cannot start a token.
+    if (bytes.size() - i >= MAX_INSTRUCTION) {
+        const size_t limit = bytes.size() - (MAX_INSTRUCTION - 1);
+        forEachInstruction(bytes.substr(i), [this, i, limit](const Instruction &instruction, const size_t offset) {
+            if (i + offset >= limit) return;
+            switch (instruction.opcode) {
+                case Opcode::Mul:
+                    multiply(instruction.lhs, instruction.rhs);
+                    break;
+                case Opcode::Do:
+                    enabled = true;
+                    break;
+                case Opcode::Dont:
+                    enabled = false;
+                    break;
+            }
+        });
+        i = limit;
+    }
+
+    while (i < bytes.size()) {
+        step(bytes[i++]);
+    }
+}
+
+template<aoc::templates::Numeric T>
+T Day03::StreamingSum<T>::sum() const noexcept { return all; }
+
+template<aoc::templates::Numeric T>
+T Day03::StreamingSum<T>::enabledSum() const noexcept { return enabledOnly; }
+
+template<aoc::templates::Numeric T>
+void Day03::StreamingSum<T>::step(const char c) noexcept {
+    const bool digit = c >= '0' && c <= '9';
+    switch (state) {
+        case State::Idle:
+            break;
+        case State::M:
+            if (c == 'u') {
+                state = State::Mu;
+                return;
+            }
+            break;
+        case State::Mu:
+            if (c == 'l') {
+                state = State::Mul;
+                return;
+            }
+            break;
+        case State::Mul:
+            if (c == '(') {
+                state = State::Lhs;
+                digits = 0;
+                lhs = 0;
+                return;
+            }
+            break;
+        case State::Lhs:
+            if (digit && digits < 3) {
+                lhs = static_cast<uint16_t>(lhs * 10 + (c - '0'));
+                ++digits;
+                return;
+            }
+            if (c == ',' && digits > 0) {
+                state = State::Rhs;
+                digits = 0;
+                rhs = 0;
+                return;
+            }
+            break;
+        case State::Rhs:
+            if (digit && digits < 3) {
+                rhs = static_cast<uint16_t>(rhs * 10 + (c - '0'));
+                ++digits;
+                return;
+            }
+            if (c == ')' && digits > 0) {
+                multiply(lhs, rhs);
+                state = State::Idle;
+                return;
+            }
+            break;
+        case State::D:
+            if (c == 'o') {
+                state = State::Do;
+                return;
+            }
+            break;
+        case State::Do:
+            if (c == '(' || c == 'n') {
+                state = c == '(' ? State::DoOpen : State::Don;
+                return;
+            }
+            break;
+        case State::DoOpen:
+            if (c == ')') {
+                enabled = true;
+                state = State::Idle;
+                return;
+            }
+            break;
+        case State::Don:
+            if (c == '\'') {
+                state = State::DonQuote;
+                return;
+            }
+            break;
+        case State::DonQuote:
+            if (c == 't') {
+                state = State::DonT;
+                return;
+            }
+            break;
+        case State::DonT:
+            if (c == '(') {
+                state = State::DonTOpen;
+                return;
+            }
+            break;
+        case State::DonTOpen:
+            if (c == ')') {
+                enabled = false;
+                state = State::Idle;
+                return;
+            }
+            break;
+    }
+    // c does not continue the token; the letters of a broken token never start another, but c itself might
+    state = c == 'm' ? State::M : c == 'd' ? State::D : State::Idle;
+}
+
+template<aoc::templates::Numeric T>
+void Day03::StreamingSum<T>::multiply(const uint16_t left, const uint16_t right) noexcept {
+    const T product = static_cast<T>(left) * static_cast<T>(right);
+    all += product;
+    if (enabled) enabledOnly += product;
 }
 
 template <aoc::templates::Numeric T>
@@ -88,8 +377,161 @@ T Day03::stoT(const std::string_view str) noexcept(false) {
     return value;
 }
 
+inline size_t Day03::matchInstruction(const std::string_view text, const size_t pos,
+                                      Instruction &instruction) noexcept {
+    const std::string_view rest = text.substr(pos);
+    if (std::array<uint16_t, 2> operands{}; const size_t length = MulInstruction::matchPrefix(rest, operands)) {
+        instruction = {Opcode::Mul, operands[0], operands[1]};
+        return length;
+    }
+    if (const size_t length = DoInstruction::matchPrefix(rest)) {
+        instruction.opcode = Opcode::Do;
+        return length;
+    }
+    if (const size_t length = DontInstruction::matchPrefix(rest)) {
+        instruction.opcode = Opcode::Dont;
+        return length;
+    }
+    return 0;
+}
+
+template<typename Visitor>
+void Day03::forEachInstruction(const std::string_view text, Visitor &&visit) {
+    Instruction instruction;
+    size_t resume = 0; // End of the last instruction, candidates inside it are not looked at
+    for (size_t first = 0; first < text.size(); first += PREFILTER_BLOCK) {
+        for (uint64_t mask = candidateMask(text, first); mask != 0; mask &= mask - 1) {
+            const size_t pos = first + static_cast<size_t>(std::countr_zero(mask));
+            if (pos < resume) continue;
+            if (const size_t length = matchInstruction(text, pos, instruction); length != 0) {
+                visit(instruction, pos);
+                resume = pos + length;
+            }
+        }
+    }
+}
+
+inline uint64_t Day03::candidateMask(const std::string_view text, const size_t first) noexcept {
+    uint64_t mask = 0;
+#if defined(__AVX2__)
+    // The shifted load reads one byte past the block, so the last block goes through the scalar loop
+    if (first + PREFILTER_BLOCK < text.size()) {
+        const auto pairs = [](const char *at) {
+            const __m256i here = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(at));
+            const __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(at + 1));
+            const __m256i muPair = _mm256_and_si256(_mm256_cmpeq_epi8(here, _mm256_set1_epi8('m')),
+                                                _mm256_cmpeq_epi8(next, _mm256_set1_epi8('u')));
+            const __m256i doPair = _mm256_and_si256(_mm256_cmpeq_epi8(here, _mm256_set1_epi8('d')),
+                                                _mm256_cmpeq_epi8(next, _mm256_set1_epi8('o')));
+            const auto bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(muPair, doPair)));
+            return static_cast<uint64_t>(bits);
+        };
+        const char *block = text.data() + first;
+        return pairs(block) | (pairs(block + 32) << 32);
+    }
+#endif
+    const size_t last = std::min(first + PREFILTER_BLOCK, text.size());
+    for (size_t pos = first; pos < last && pos + 1 < text.size(); ++pos) {
+        const char c = text[pos];
+        const char next = text[pos + 1];
+        const bool candidate = (c == 'm' && next == 'u') || (c == 'd' && next == 'o');
+        mask |= static_cast<uint64_t>(candidate) << (pos - first);
+    }
+    return mask;
+}
+
 template <aoc::templates::Numeric T>
-T Day03::processMultiplications(const std::string_view text) {
+T Day03::processMultiplications(const std::string_view text) noexcept {
+    T sum{0};
+    forEachInstruction(text, [&sum](const Instruction &instruction, size_t) {
+        if (instruction.opcode == Opcode::Mul) {
+            sum += static_cast<T>(instruction.lhs) * static_cast<T>(instruction.rhs);
+        }
+    });
+    return sum;
+}
+
+template <aoc::templates::Numeric T>
+T Day03::sumMultiplicationsDD(const std::string_view input) noexcept {
+    T sum{0};
+    bool enabled = true;
+    forEachInstruction(input, [&sum, &enabled](const Instruction &instruction, size_t) {
+        switch (instruction.opcode) {
+            case Opcode::Mul:
+                if (enabled) sum += static_cast<T>(instruction.lhs) * static_cast<T>(instruction.rhs);
+                break;
+            case Opcode::Do:
+                enabled = true;
+                break;
+            case Opcode::Dont:
+                enabled = false;
+                break;
+        }
+    });
+    return sum;
+}
+
+template<aoc::templates::Numeric T>
+Day03::ChunkSummary<T> Day03::summarizeChunk(const std::string_view text, const size_t begin,
+                                             const size_t end) noexcept {
+    ChunkSummary<T> summary;
+    // Whether products count, followed for both possible starting states at once
+    bool startedEnabled = true;
+    bool startedDisabled = false;
+    const std::string_view window = text.substr(begin, std::min(end + MAX_INSTRUCTION - 1, text.size()) - begin);
+    forEachInstruction(window, [&](const Instruction &instruction, const size_t offset) {
+        if (begin + offset >= end) return; // Belongs to the next chunk
+        switch (instruction.opcode) {
+            case Opcode::Mul: {
+                const T product = static_cast<T>(instruction.lhs) * static_cast<T>(instruction.rhs);
+                summary.all += product;
+                if (startedEnabled) summary.whenEnabled += product;
+                if (startedDisabled) summary.whenDisabled += product;
+                break;
+            }
+            case Opcode::Do:
+                startedEnabled = startedDisabled = true;
+                summary.exit = Toggle::Enable;
+                break;
+            case Opcode::Dont:
+                startedEnabled = startedDisabled = false;
+                summary.exit = Toggle::Disable;
+                break;
+        }
+    });
+    return summary;
+}
+
+template<aoc::templates::Numeric T>
+Day03::ChunkSummary<T> Day03::combine(const ChunkSummary<T> &left, const ChunkSummary<T> &right) noexcept {
+    // Whether right starts enabled depends on left's exit when it has one, on the caller's start otherwise
+    const auto rightAfter = [&right, &left](const bool startEnabled) {
+        const bool enabled = left.exit == Toggle::Keep ? startEnabled : left.exit == Toggle::Enable;
+        return enabled ? right.whenEnabled : right.whenDisabled;
+    };
+    return {
+        left.all + right.all,
+        left.whenEnabled + rightAfter(true),
+        left.whenDisabled + rightAfter(false),
+        right.exit == Toggle::Keep ? left.exit : right.exit
+    };
+}
+
+template<aoc::templates::Numeric T>
+Day03::ChunkSummary<T> Day03::scanParallel(const std::string_view text, const size_t chunkSize) {
+    // parallel_reduce joins neighbouring ranges left to right, which is all combine needs
+    return tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, text.size(), std::max<size_t>(chunkSize, 1)),
+        ChunkSummary<T>{},
+        [text](const auto &range, const ChunkSummary<T> &before) {
+            return combine(before, summarizeChunk<T>(text, range.begin(), range.end()));
+        },
+        [](const ChunkSummary<T> &left, const ChunkSummary<T> &right) { return combine(left, right); }
+    );
+}
+
+template <aoc::templates::Numeric T>
+T Day03::processMultiplicationsRegex(const std::string_view text) {
     const std::string str{text};
     const auto end = regexIterator();
 
@@ -108,7 +550,7 @@ T Day03::processMultiplications(const std::string_view text) {
 }
 
 template <aoc::templates::Numeric T>
-T Day03::sumMultiplicationsDD(const std::string& input) noexcept {
+T Day03::sumMultiplicationsDDRegex(const std::string& input) noexcept {
     auto sections = std::ranges::subrange(  // Gather all sections that match the pattern in a vector
             regexIterator(input.begin(), input.end(), sectionPattern),
             regexIterator()
@@ -120,10 +562,87 @@ T Day03::sumMultiplicationsDD(const std::string& input) noexcept {
         sections.begin(), sections.end(),
         T{0},
         std::plus{},
-        processMultiplications<T>
+        processMultiplicationsRegex<T>
     );
 }
 
+inline Day03::TokenStream Day03::tokenize(const std::string_view text) {
+    TokenStream tokens;
+    forEachInstruction(text, [&tokens](const Instruction &instruction, const size_t offset) {
+        tokens.opcodes.push_back(instruction.opcode);
+        tokens.lhs.push_back(instruction.opcode == Opcode::Mul ? instruction.lhs : uint16_t{0});
+        tokens.rhs.push_back(instruction.opcode == Opcode::Mul ? instruction.rhs : uint16_t{0});
+        tokens.offsets.push_back(offset);
+    });
+    return tokens;
+}
+
+template<aoc::templates::Numeric T>
+T Day03::sumAll(const TokenStream &tokens) noexcept {
+    return std::transform_reduce(
+        std::execution::unseq,
+        tokens.lhs.begin(), tokens.lhs.end(),
+        tokens.rhs.begin(),
+        T{0},
+        std::plus{},
+        [](const uint16_t a, const uint16_t b) { return static_cast<T>(a) * static_cast<T>(b); }
+    );
+}
+
+template<aoc::templates::Numeric T>
+T Day03::sumEnabled(const TokenStream &tokens) noexcept {
+    // The state is carried from token to token, but selected without branches
+    T sum{0};
+    T enabled{1};
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        const Opcode opcode = tokens.opcodes[i];
+        enabled = opcode == Opcode::Do ? T{1} : opcode == Opcode::Dont ? T{0} : enabled;
+        sum += enabled * static_cast<T>(tokens.lhs[i]) * static_cast<T>(tokens.rhs[i]);
+    }
+    return sum;
+}
+
+inline std::vector<Day03::Section> Day03::sections(const TokenStream &tokens) {
+    std::vector<Section> result{Section{}};
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        const Opcode opcode = tokens.opcodes[i];
+        if (opcode == Opcode::Mul) {
+            ++result.back().multiplications;
+        } else if (const bool enable = opcode == Opcode::Do; enable != result.back().enabled) {
+            result.push_back({enable, tokens.offsets[i], 0});
+        }
+    }
+    return result;
+}
+
+inline void Day03::allQueriesFromTokens() {
+    const auto file = aoc::MappedFile::open(INPUT_FILE);
+    if (!file) {
+        std::println("Error opening file: {}", file.error().what());
+        return;
+    }
+
+    const auto bytes = file->bytes();
+    const auto tokens = tokenize(std::string_view{reinterpret_cast<const char *>(bytes.data()), bytes.size()});
+    const auto parts = sections(tokens);
+    const auto enabledSections = std::ranges::count_if(parts, &Section::enabled);
+    std::println("Sum of multiplications: {}, enabled only: {}, {} tokens in {} sections ({} enabled)",
+                 sumAll<int64_t>(tokens), sumEnabled<int64_t>(tokens), tokens.size(), parts.size(), enabledSections);
+}
+
+inline void Day03::bothPartsParallel() {
+    const auto file = aoc::MappedFile::open(INPUT_FILE);
+    if (!file) {
+        std::println("Error opening file: {}", file.error().what());
+        return;
+    }
+
+    const auto bytes = file->bytes();
+    const std::string_view input{reinterpret_cast<const char *>(bytes.data()), bytes.size()};
+    const auto summary = scanParallel<int64_t>(input);
+    std::println("Sum of multiplications: {}, enabled only: {} (parallel)", summary.all, summary.whenEnabled);
+}
+
 inline std::expected<std::ifstream, aoc::exceptions::AocException> Day03::openFile(
     const std::filesystem::path &path) noexcept {
     if (!exists(path)) {
@@ -135,3 +654,28 @@ inline std::expected<std::ifstream, aoc::exceptions::AocException> Day03::openFi
     }
     return f;
 }
+
+template<aoc::templates::Numeric T>
+std::expected<Day03::StreamingSum<T>, aoc::exceptions::AocException> Day03::streamFile(
+    const std::filesystem::path &path) noexcept {
+    auto file = openFile(path);
+    if (!file) {
+        return std::unexpected(file.error());
+    }
+
+    StreamingSum<T> engine;
+    std::array<char, STREAM_BLOCK_SIZE> block{};
+    try {
+        auto &stream = file.value();
+        while (stream) {
+            stream.read(block.data(), static_cast<std::streamsize>(block.size()));
+            engine.feed(std::string_view{block.data(), static_cast<size_t>(stream.gcount())});
+        }
+        if (!stream.eof()) {
+            return std::unexpected(aoc::exceptions::DataFormatError("Stream in invalid state"));
+        }
+    } catch (const std::exception &) {
+        return std::unexpected(aoc::exceptions::DataFormatError("Error reading input"));
+    }
+    return engine;
+}
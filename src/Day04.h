@@ -10,9 +10,23 @@
 #include <ranges>
 #include <span>
 #include <algorithm>
+#include <bit>
+#include <cstdint>
 #include <expected>
+#include <limits>
+#include <numeric>
 
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "AhoCorasick.h"
 #include "AocExceptions.h"
+#include "RadixSort.h"
 
 class Day04 {
 public:
@@ -26,11 +40,14 @@ public:
 #ifdef TESTING
     friend class Day04Test;
 #endif
+#ifdef BENCHMARKING
+    friend class Day04Bench;
+#endif
 
 private:
     // Used for both parts
     static inline std::filesystem::path INPUT_FILE{std::filesystem::path{"../data"} / "d4p1.txt"};
-    static inline std::string_view target = "XMAS";
+    static constexpr std::string_view target = "XMAS";
 
     // Part 1
     static constexpr auto directions = std::to_array<std::uint8_t>({
@@ -53,12 +70,43 @@ private:
         static constexpr MatchResult success(std::size_t idx) noexcept;
     };
 
+    // Grid index and direction of one match, see findAllPacked
+    using PackedMatch = std::uint32_t;
+    static constexpr unsigned PACKED_DIRECTION_BITS = 3; // directions.size() == 8
+    // Largest grid whose every index fits next to the direction bits
+    static constexpr std::size_t PACKED_CELL_LIMIT =
+        (std::size_t{std::numeric_limits<PackedMatch>::max()} >> PACKED_DIRECTION_BITS) + 1;
+
     struct SearchTask {
         std::size_t startIdx;
 
         constexpr explicit SearchTask(std::size_t idx) noexcept;
     };
 
+    // Grid surrounded by a border of SENTINEL cells as wide as the longest step from a start cell, so
+    // every direction stride lands inside the buffer. Rows are stride bytes apart, a multiple of a cache line.
+    struct PaddedGrid {
+        static constexpr std::size_t BORDER = target.length() - 1;
+        static constexpr char SENTINEL = '\0';
+        static constexpr std::size_t ROW_ALIGNMENT = 64;
+
+        std::size_t rows = 0;
+        std::size_t cols = 0;
+        std::size_t stride = 0;
+        std::vector<char> cells;
+
+        [[nodiscard]] constexpr std::size_t index(std::size_t row, std::size_t col) const noexcept;
+    };
+
+    // Bitboard: plane k holds one bit per cell equal to target[k], each row packed into wordsPerRow words
+    // with column c at bit c % 64 of word c / 64. Bits past the last column are zero.
+    struct BitGrid {
+        std::size_t rows = 0;
+        std::size_t cols = 0;
+        std::size_t wordsPerRow = 0;
+        std::array<std::vector<std::uint64_t>, target.length()> planes;
+    };
+
     // Used for both parts
     // --------------------------------------------------------------------------------------------- //
     static std::pair<std::vector<char>, size_t> getDataArray(std::ifstream &file) noexcept;
@@ -71,6 +119,8 @@ private:
 
     [[nodiscard]] static constexpr auto fromIndex(size_t numCols, std::size_t idx) noexcept;
 
+    [[nodiscard]] static PaddedGrid toPaddedGrid(const std::vector<char> &data, size_t rows, size_t cols);
+
     // Part 1
     // --------------------------------------------------------------------------------------------- //
     [[nodiscard]] static constexpr auto decodeDirection(std::uint8_t dir) noexcept;
@@ -82,20 +132,88 @@ private:
     ) noexcept;
 
     [[nodiscard]] static std::vector<std::tuple<std::size_t, std::size_t, std::size_t> >
-    processSearchTask(const SearchTask &task, const std::vector<char> &data, std::size_t rows,
-                      std::size_t cols) noexcept;
+    processSearchTask(const SearchTask &task, const PaddedGrid &grid) noexcept;
 
     [[nodiscard]] static std::vector<std::tuple<std::size_t, std::size_t, std::size_t> > findAll(
         const std::vector<char> &data, const std::vector<size_t> &startPositions, size_t rows, size_t cols
     ) noexcept;
 
+    // Bit dir set for every direction in which target starts at the padded index
+    [[nodiscard]] static std::uint8_t matchMask(const PaddedGrid &grid, std::size_t paddedIdx) noexcept;
+
+    // Same as findAll(...).size() without building any results
+    [[nodiscard]] static size_t countAll(const PaddedGrid &grid, std::span<const size_t> startPositions) noexcept;
+
+    // Same matches as findAll, packed as (index << 3) | dir so they sort into findAll's order. Threads append to
+    // their own arena, which are joined once at the end. Fails if an index does not fit in 29 bits.
+    [[nodiscard]] static std::expected<std::vector<PackedMatch>, aoc::exceptions::AocException> findAllPacked(
+        const PaddedGrid &grid, std::span<const size_t> startPositions) noexcept;
+
+    [[nodiscard]] static constexpr std::tuple<std::size_t, std::size_t, std::size_t> unpackMatch(
+        PackedMatch match, size_t cols) noexcept;
+
     // Part 2
     // --------------------------------------------------------------------------------------------- //
-    [[nodiscard]] static size_t checkPatternBlock(const std::vector<char> &data, size_t rows, size_t cols,
-                                                  std::span<const size_t> positions) noexcept;
+    [[nodiscard]] static size_t checkPatternBlock(const PaddedGrid &grid, std::span<const size_t> positions) noexcept;
 
     [[nodiscard]] static size_t countPatterns(const std::vector<char> &data, size_t rows, size_t cols,
                                               const std::vector<size_t> &centerAPositions) noexcept;
+
+    // Tiled scan, both parts
+    // --------------------------------------------------------------------------------------------- //
+    // Per-core L2 size the tiles are shaped for, a typical figure rather than a measured one
+    static constexpr std::size_t L2_BYTES = 256 * 1024;
+    // Height of column tiles, enough rows to amortise the halo read around them
+    static constexpr std::size_t TILE_MIN_ROWS = 16;
+
+    struct TileShape {
+        std::size_t rows;
+        std::size_t cols;
+    };
+
+    // bandRows / tileCols if non-zero. Scanning one row reads the 1 + 2 * BORDER rows around it, once per
+    // direction; tiles span whole rows while that window fits L2_BYTES and narrow to a multiple of
+    // ROW_ALIGNMENT columns when it does not. Rows per tile then fill L2_BYTES together with the halo.
+    [[nodiscard]] static TileShape tileShape(const PaddedGrid &grid, std::size_t bandRows,
+                                             std::size_t tileCols) noexcept;
+
+    // Sum of count(firstRow, lastRow, firstCol, lastCol) over all tiles, one TBB task per tile
+    template<typename F>
+    [[nodiscard]] static size_t sumOverTiles(const PaddedGrid &grid, TileShape shape, F &&count);
+
+    // Same count as findAll(...).size(). Tiles run in parallel into per-thread counters; a tile reads the
+    // halo around it but only counts words starting inside it, so no match is counted twice.
+    [[nodiscard]] static size_t countWordsTiled(const PaddedGrid &grid, std::size_t bandRows = 0,
+                                                std::size_t tileCols = 0) noexcept;
+
+    // Same count as countPatterns, tiled the same way with each X-MAS owned by the tile holding its A
+    [[nodiscard]] static size_t countCrossesTiled(const PaddedGrid &grid, std::size_t bandRows = 0,
+                                                  std::size_t tileCols = 0) noexcept;
+
+    // Dictionary search
+    // --------------------------------------------------------------------------------------------- //
+    // Index into directions of the step (dx, dy)
+    [[nodiscard]] static constexpr std::size_t directionIndex(std::ptrdiff_t dx, std::ptrdiff_t dy) noexcept;
+
+    // Every occurrence of every word in all eight directions, per word as findAll's sorted (row, col, dir)
+    // tuples. One automaton holds each word and its reverse and walks every row, column and diagonal once.
+    [[nodiscard]] static std::expected<std::vector<std::vector<std::tuple<std::size_t, std::size_t, std::size_t> > >,
+        aoc::exceptions::AocException> findWords(const std::vector<char> &data, size_t rows, size_t cols,
+                                                  std::span<const std::string_view> words) noexcept;
+
+    // Bitboard, both parts
+    // --------------------------------------------------------------------------------------------- //
+    [[nodiscard]] static BitGrid toBitGrid(const std::vector<char> &data, size_t rows, size_t cols);
+
+    // Bits for the 64 columns starting at word * 64 + shift of one row, zero outside the grid
+    [[nodiscard]] static std::uint64_t shiftedWord(const BitGrid &grid, std::size_t plane, std::size_t row,
+                                                   std::size_t word, std::ptrdiff_t shift) noexcept;
+
+    // Same count as findAll(...).size(): per direction, plane k is shifted by k steps and ANDed, 64 cells at once
+    [[nodiscard]] static size_t countWordsBitboard(const BitGrid &grid) noexcept;
+
+    // Same count as countPatterns, evaluated on the A plane with both diagonals shifted in
+    [[nodiscard]] static size_t countCrossesBitboard(const BitGrid &grid) noexcept;
 };
 
 inline void Day04::partOne() {
@@ -114,9 +232,9 @@ inline void Day04::partOne() {
         }
     }
 
-    const auto results = findAll(data, startPositions, rows, cols);
+    const auto grid = toPaddedGrid(data, rows, cols);
 
-    std::println("Matches: {}", results.size());
+    std::println("Matches: {}", countAll(grid, startPositions));
 }
 
 inline void Day04::partTwo() {
@@ -182,6 +300,22 @@ constexpr auto Day04::fromIndex(const size_t numCols, const std::size_t idx) noe
     return std::pair{idx / numCols, idx % numCols};
 }
 
+constexpr std::size_t Day04::PaddedGrid::index(const std::size_t row, const std::size_t col) const noexcept {
+    return (row + BORDER) * stride + col + BORDER;
+}
+
+inline Day04::PaddedGrid Day04::toPaddedGrid(const std::vector<char> &data, const size_t rows, const size_t cols) {
+    constexpr auto BORDER = PaddedGrid::BORDER;
+    const size_t stride = (cols + 2 * BORDER + PaddedGrid::ROW_ALIGNMENT - 1) / PaddedGrid::ROW_ALIGNMENT *
+                          PaddedGrid::ROW_ALIGNMENT;
+    PaddedGrid grid{rows, cols, stride, std::vector<char>((rows + 2 * BORDER) * stride, PaddedGrid::SENTINEL)};
+    for (size_t row = 0; row < rows; ++row) {
+        std::copy_n(data.begin() + static_cast<std::ptrdiff_t>(row * cols), cols,
+                    grid.cells.begin() + static_cast<std::ptrdiff_t>(grid.index(row, 0)));
+    }
+    return grid;
+}
+
 constexpr auto Day04::decodeDirection(const std::uint8_t dir) noexcept {
     static constexpr std::uint8_t LOW_NIBBLE_MASK = 0x0F;
     static constexpr std::uint8_t SIGN_BIT_X = 0x08;
@@ -205,42 +339,36 @@ constexpr auto Day04::decodeDirection(const std::uint8_t dir) noexcept {
 
 constexpr Day04::MatchResult Day04::checkPattern(const std::vector<char> &data, const std::size_t startIdx,
                                                  const std::ptrdiff_t stride) noexcept {
+    // Every cell is compared regardless, which the padded border makes safe and keeps the loop branch-free
     auto currIdx = startIdx;
+    bool matched = true;
     for (std::size_t k = 1; k < target.length(); ++k) {
         currIdx = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(currIdx) + stride);
-        if (data[currIdx] != target[k]) {
-            return MatchResult::failure();
-        }
+        matched &= data[currIdx] == target[k];
     }
-    return MatchResult::success(currIdx);
+    return matched ? MatchResult::success(currIdx) : MatchResult::failure();
 }
 
 inline std::vector<std::tuple<std::size_t, std::size_t, std::size_t> > Day04::processSearchTask(const SearchTask &task,
-    const std::vector<char> &data, const std::size_t rows, const std::size_t cols) noexcept {
+    const PaddedGrid &grid) noexcept {
     std::vector<std::tuple<std::size_t, std::size_t, std::size_t> > localResults;
 
-    auto [startI, startJ] = fromIndex(cols, task.startIdx);
+    auto [startI, startJ] = fromIndex(grid.cols, task.startIdx);
+    const auto startIdx = grid.index(startI, startJ);
 
-    if (data[task.startIdx] != target[0]) {
+    if (grid.cells[startIdx] != target[0]) {
         return localResults;
     }
 
+    // The border absorbs every step that leaves the grid, so no direction needs a bounds check
     for (std::size_t dir = 0; dir < directions.size(); ++dir) {
         auto [dx, dy] = decodeDirection(directions[dir]);
 
-        const auto targetLen = static_cast<std::ptrdiff_t>(target.length() - 1);
-        const auto endI = static_cast<std::ptrdiff_t>(startI) + dx * targetLen;
-        if (const auto endJ = static_cast<std::ptrdiff_t>(startJ) + dy * targetLen;
-            endI < 0 || static_cast<std::size_t>(endI) >= rows ||
-            endJ < 0 || static_cast<std::size_t>(endJ) >= cols) {
-            continue;
-        }
-
         const std::ptrdiff_t stride = static_cast<std::ptrdiff_t>(dx) *
-                                      static_cast<std::ptrdiff_t>(cols) +
+                                      static_cast<std::ptrdiff_t>(grid.stride) +
                                       static_cast<std::ptrdiff_t>(dy);
 
-        if (checkPattern(data, task.startIdx, stride).valid) {
+        if (checkPattern(grid.cells, startIdx, stride).valid) {
             localResults.emplace_back(startI, startJ, dir);
         }
     }
@@ -249,6 +377,7 @@ inline std::vector<std::tuple<std::size_t, std::size_t, std::size_t> > Day04::pr
 
 inline std::vector<std::tuple<std::size_t, std::size_t, std::size_t> > Day04::findAll(const std::vector<char> &data,
     const std::vector<size_t> &startPositions, const size_t rows, const size_t cols) noexcept {
+    const auto grid = toPaddedGrid(data, rows, cols);
     std::vector<SearchTask> tasks;
     tasks.reserve(startPositions.size());
 
@@ -263,8 +392,8 @@ inline std::vector<std::tuple<std::size_t, std::size_t, std::size_t> > Day04::fi
         std::execution::par_unseq,
         tasks.begin(), tasks.end(),
         allResults.begin(),
-        [&data, rows, cols](const SearchTask &task) {
-            return processSearchTask(task, data, rows, cols);
+        [&grid](const SearchTask &task) {
+            return processSearchTask(task, grid);
         }
     );
 
@@ -292,21 +421,84 @@ inline std::vector<std::tuple<std::size_t, std::size_t, std::size_t> > Day04::fi
     return finalResults;
 }
 
-inline size_t Day04::checkPatternBlock(const std::vector<char> &data, const size_t rows, const size_t cols,
-                                       std::span<const size_t> positions) noexcept {
+inline std::uint8_t Day04::matchMask(const PaddedGrid &grid, const std::size_t paddedIdx) noexcept {
+    std::uint8_t mask = 0;
+    for (std::size_t dir = 0; dir < directions.size(); ++dir) {
+        const auto [dx, dy] = decodeDirection(directions[dir]);
+        const std::ptrdiff_t stride = dx * static_cast<std::ptrdiff_t>(grid.stride) + dy;
+        mask |= static_cast<std::uint8_t>(checkPattern(grid.cells, paddedIdx, stride).valid ? 1U << dir : 0U);
+    }
+    return grid.cells[paddedIdx] == target[0] ? mask : std::uint8_t{0};
+}
+
+inline size_t Day04::countAll(const PaddedGrid &grid, const std::span<const size_t> startPositions) noexcept {
+    return std::transform_reduce(
+        std::execution::par_unseq,
+        startPositions.begin(), startPositions.end(),
+        std::size_t{0},
+        std::plus<>{},
+        [&grid](const size_t idx) {
+            const auto [row, col] = fromIndex(grid.cols, idx);
+            return static_cast<std::size_t>(std::popcount(matchMask(grid, grid.index(row, col))));
+        }
+    );
+}
+
+inline std::expected<std::vector<Day04::PackedMatch>, aoc::exceptions::AocException> Day04::findAllPacked(
+    const PaddedGrid &grid, const std::span<const size_t> startPositions) noexcept {
+    if (grid.rows * grid.cols > PACKED_CELL_LIMIT) {
+        return std::unexpected(aoc::exceptions::AlgorithmError("Grid too large for packed matches"));
+    }
+    try {
+        constexpr size_t GRAIN_SIZE = 4096;
+        tbb::enumerable_thread_specific<std::vector<PackedMatch> > arenas;
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, startPositions.size(), GRAIN_SIZE), [&](const auto &range) {
+            auto &arena = arenas.local();
+            for (size_t i = range.begin(); i < range.end(); ++i) {
+                const auto idx = startPositions[i];
+                const auto [row, col] = fromIndex(grid.cols, idx);
+                for (auto mask = matchMask(grid, grid.index(row, col)); mask != 0; mask &= mask - 1) {
+                    arena.push_back(static_cast<PackedMatch>(idx << PACKED_DIRECTION_BITS) |
+                                    static_cast<PackedMatch>(std::countr_zero(mask)));
+                }
+            }
+        });
+
+        size_t total = 0;
+        for (const auto &arena: arenas) {
+            total += arena.size();
+        }
+        std::vector<PackedMatch> matches;
+        matches.reserve(total);
+        for (const auto &arena: arenas) {
+            matches.insert(matches.end(), arena.begin(), arena.end());
+        }
+        // Arenas fill in whatever order the scheduler picks
+        aoc::sort::parallelRadixSort<PackedMatch>(matches);
+        return matches;
+    } catch (const std::exception &) {
+        return std::unexpected(aoc::exceptions::AlgorithmError("Failed to allocate match arenas"));
+    }
+}
+
+constexpr std::tuple<std::size_t, std::size_t, std::size_t> Day04::unpackMatch(const PackedMatch match,
+                                                                               const size_t cols) noexcept {
+    const auto [row, col] = fromIndex(cols, match >> PACKED_DIRECTION_BITS);
+    return {row, col, match & ((1U << PACKED_DIRECTION_BITS) - 1)};
+}
+
+inline size_t Day04::checkPatternBlock(const PaddedGrid &grid, std::span<const size_t> positions) noexcept {
     size_t matches = 0;
 
     for (const auto pos: positions) {
-        const auto [row, col] = fromIndex(cols, pos);
-
-        // Quick bounds check
-        if (row == 0 || row + 1 >= rows || col == 0 || col + 1 >= cols) continue;
+        const auto [row, col] = fromIndex(grid.cols, pos);
+        const auto center = grid.index(row, col);
 
-        // Get the characters in the diagonals
-        const char topLeft = data[toIndex(cols, row - 1, col - 1)];
-        const char topRight = data[toIndex(cols, row - 1, col + 1)];
-        const char bottomLeft = data[toIndex(cols, row + 1, col - 1)];
-        const char bottomRight = data[toIndex(cols, row + 1, col + 1)];
+        // Get the characters in the diagonals, sentinels for an A on the edge of the grid
+        const char topLeft = grid.cells[center - grid.stride - 1];
+        const char topRight = grid.cells[center - grid.stride + 1];
+        const char bottomLeft = grid.cells[center + grid.stride - 1];
+        const char bottomRight = grid.cells[center + grid.stride + 1];
 
         // Check if diagonals form MS patterns
         const bool topLeftBottomRight = (topLeft == 'M' && bottomRight == 'S') ||
@@ -324,12 +516,276 @@ inline size_t Day04::countPatterns(const std::vector<char> &data, const size_t r
                                    const std::vector<size_t> &centerAPositions) noexcept {
     constexpr size_t BLOCK_SIZE = 64;
     size_t totalMatches = 0;
+    const auto grid = toPaddedGrid(data, rows, cols);
 
     const std::span positions(centerAPositions);
     for (size_t i = 0; i < positions.size(); i += BLOCK_SIZE) {
         const size_t blockCount = std::min(BLOCK_SIZE, positions.size() - i);
-        totalMatches += checkPatternBlock(data, rows, cols, positions.subspan(i, blockCount));
+        totalMatches += checkPatternBlock(grid, positions.subspan(i, blockCount));
     }
 
     return totalMatches;
 }
+
+inline Day04::TileShape Day04::tileShape(const PaddedGrid &grid, const std::size_t bandRows,
+                                         const std::size_t tileCols) noexcept {
+    constexpr auto BORDER = PaddedGrid::BORDER;
+    std::size_t cols = tileCols;
+    if (cols == 0) {
+        constexpr std::size_t narrow = L2_BYTES / (TILE_MIN_ROWS + 2 * BORDER) / PaddedGrid::ROW_ALIGNMENT *
+                                       PaddedGrid::ROW_ALIGNMENT;
+        cols = (1 + 2 * BORDER) * grid.stride <= L2_BYTES ? grid.cols : narrow;
+    }
+    cols = std::clamp<std::size_t>(cols, 1, std::max<std::size_t>(grid.cols, 1));
+
+    std::size_t rows = bandRows;
+    if (rows == 0) {
+        const std::size_t width = cols == grid.cols ? grid.stride : cols + 2 * BORDER;
+        const std::size_t fitting = L2_BYTES / std::max<std::size_t>(width, 1);
+        rows = fitting > 2 * BORDER ? fitting - 2 * BORDER : 1;
+    }
+    return {rows, cols};
+}
+
+template<typename F>
+size_t Day04::sumOverTiles(const PaddedGrid &grid, const TileShape shape, F &&count) {
+    const std::size_t down = (grid.rows + shape.rows - 1) / shape.rows;
+    const std::size_t across = (grid.cols + shape.cols - 1) / shape.cols;
+
+    // simple_partitioner with the default grain of 1 keeps every task exactly one tile
+    tbb::enumerable_thread_specific<size_t> counters(0);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, down * across), [&](const auto &tiles) {
+        size_t matches = 0;
+        for (size_t tile = tiles.begin(); tile < tiles.end(); ++tile) {
+            const size_t row = tile / across * shape.rows;
+            const size_t col = tile % across * shape.cols;
+            matches += count(row, std::min(row + shape.rows, grid.rows), col, std::min(col + shape.cols, grid.cols));
+        }
+        counters.local() += matches;
+    }, tbb::simple_partitioner{});
+    return counters.combine(std::plus<>{});
+}
+
+inline size_t Day04::countWordsTiled(const PaddedGrid &grid, const std::size_t bandRows,
+                                     const std::size_t tileCols) noexcept {
+    std::array<std::ptrdiff_t, directions.size()> strides{};
+    for (std::size_t dir = 0; dir < directions.size(); ++dir) {
+        const auto [dx, dy] = decodeDirection(directions[dir]);
+        strides[dir] = dx * static_cast<std::ptrdiff_t>(grid.stride) + dy;
+    }
+
+    return sumOverTiles(grid, tileShape(grid, bandRows, tileCols), [&](const size_t firstRow, const size_t lastRow,
+                                                                        const size_t firstCol, const size_t lastCol) {
+        size_t matches = 0;
+        for (size_t row = firstRow; row < lastRow; ++row) {
+            const char *cells = grid.cells.data() + grid.index(row, 0);
+            for (const auto stride: strides) {
+                // Sentinels in the border fail every comparison, so the columns need no checks
+                for (size_t col = firstCol; col < lastCol; ++col) {
+                    const char *cell = cells + col;
+                    // Constant trip count, unrolled into one comparison per letter
+                    bool matched = true;
+                    for (std::size_t k = 0; k < target.length(); ++k) {
+                        matched &= cell[static_cast<std::ptrdiff_t>(k) * stride] == target[k];
+                    }
+                    matches += static_cast<size_t>(matched);
+                }
+            }
+        }
+        return matches;
+    });
+}
+
+inline size_t Day04::countCrossesTiled(const PaddedGrid &grid, const std::size_t bandRows,
+                                       const std::size_t tileCols) noexcept {
+    const auto stride = static_cast<std::ptrdiff_t>(grid.stride);
+
+    return sumOverTiles(grid, tileShape(grid, bandRows, tileCols), [&](const size_t firstRow, const size_t lastRow,
+                                                                        const size_t firstCol, const size_t lastCol) {
+        size_t matches = 0;
+        for (size_t row = firstRow; row < lastRow; ++row) {
+            const char *cells = grid.cells.data() + grid.index(row, 0);
+            for (size_t col = firstCol; col < lastCol; ++col) {
+                const char *center = cells + col;
+                const char topLeft = center[-stride - 1];
+                const char topRight = center[-stride + 1];
+                const char bottomLeft = center[stride - 1];
+                const char bottomRight = center[stride + 1];
+                const bool falling = ((topLeft == 'M') & (bottomRight == 'S')) |
+                                     ((topLeft == 'S') & (bottomRight == 'M'));
+                const bool rising = ((topRight == 'M') & (bottomLeft == 'S')) |
+                                    ((topRight == 'S') & (bottomLeft == 'M'));
+                matches += static_cast<size_t>((center[0] == 'A') & falling & rising);
+            }
+        }
+        return matches;
+    });
+}
+
+constexpr std::size_t Day04::directionIndex(const std::ptrdiff_t dx, const std::ptrdiff_t dy) noexcept {
+    std::size_t dir = 0;
+    while (dir < directions.size() && decodeDirection(directions[dir]) != std::pair<std::int8_t, std::int8_t>(dx, dy)) {
+        ++dir;
+    }
+    return dir;
+}
+
+inline std::expected<std::vector<std::vector<std::tuple<std::size_t, std::size_t, std::size_t> > >,
+    aoc::exceptions::AocException> Day04::findWords(const std::vector<char> &data, const size_t rows,
+                                                    const size_t cols,
+                                                    const std::span<const std::string_view> words) noexcept {
+    // Word i is automaton word 2i and its reverse 2i + 1
+    std::vector<std::string> reversed;
+    reversed.reserve(words.size());
+    std::vector<std::string_view> dictionary;
+    dictionary.reserve(2 * words.size());
+    for (const auto word: words) {
+        reversed.emplace_back(word.rbegin(), word.rend());
+    }
+    for (size_t i = 0; i < words.size(); ++i) {
+        dictionary.push_back(words[i]);
+        dictionary.push_back(reversed[i]);
+    }
+    const auto automaton = aoc::AhoCorasick::build(dictionary);
+    if (!automaton) {
+        return std::unexpected(automaton.error());
+    }
+
+    std::vector<std::vector<std::tuple<std::size_t, std::size_t, std::size_t> > > results(words.size());
+    const auto numRows = static_cast<std::ptrdiff_t>(rows);
+    const auto numCols = static_cast<std::ptrdiff_t>(cols);
+    const auto inside = [numRows, numCols](const std::ptrdiff_t i, const std::ptrdiff_t j) {
+        return i >= 0 && i < numRows && j >= 0 && j < numCols;
+    };
+
+    // Rows, columns and both diagonals, each walked forward only; reversed words match the backward direction
+    constexpr auto orientations = std::to_array<std::pair<std::ptrdiff_t, std::ptrdiff_t> >({
+        {0, 1}, {1, 0}, {1, 1}, {1, -1}
+    });
+    for (const auto &[dx, dy]: orientations) {
+        const auto forward = directionIndex(dx, dy);
+        const auto backward = directionIndex(-dx, -dy);
+        for (std::ptrdiff_t row = 0; row < numRows; ++row) {
+            for (std::ptrdiff_t col = 0; col < numCols; ++col) {
+                // A line starts at a cell whose predecessor along it is outside the grid
+                if (inside(row - dx, col - dy)) continue;
+
+                auto state = aoc::AhoCorasick::start();
+                for (auto i = row, j = col; inside(i, j); i += dx, j += dy) {
+                    state = automaton->next(state, data[static_cast<size_t>(i * numCols + j)]);
+                    automaton->forEachMatch(state, [&](const size_t id) {
+                        const auto steps = static_cast<std::ptrdiff_t>(automaton->wordLength(id)) - 1;
+                        if (id % 2 == 0) {
+                            results[id / 2].emplace_back(static_cast<size_t>(i - dx * steps),
+                                                        static_cast<size_t>(j - dy * steps), forward);
+                        } else {
+                            results[id / 2].emplace_back(static_cast<size_t>(i), static_cast<size_t>(j), backward);
+                        }
+                    });
+                }
+            }
+        }
+    }
+
+    for (auto &found: results) {
+        std::ranges::sort(found);
+    }
+    return results;
+}
+
+inline Day04::BitGrid Day04::toBitGrid(const std::vector<char> &data, const size_t rows, const size_t cols) {
+    BitGrid grid{rows, cols, (cols + 63) / 64, {}};
+    for (auto &plane: grid.planes) {
+        plane.assign(rows * grid.wordsPerRow, 0);
+    }
+
+    for (size_t row = 0; row < rows; ++row) {
+        const char *cells = data.data() + row * cols;
+        for (size_t word = 0; word < grid.wordsPerRow; ++word) {
+            const size_t first = word * 64;
+            const size_t count = std::min<size_t>(64, cols - first);
+            for (size_t k = 0; k < grid.planes.size(); ++k) {
+                std::uint64_t bits = 0;
+#if defined(__AVX2__)
+                if (count == 64) {
+                    const __m256i letter = _mm256_set1_epi8(target[k]);
+                    const auto half = [&letter](const char *at) {
+                        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(at));
+                        return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, letter)));
+                    };
+                    bits = half(cells + first) | (std::uint64_t{half(cells + first + 32)} << 32);
+                    grid.planes[k][row * grid.wordsPerRow + word] = bits;
+                    continue;
+                }
+#endif
+                for (size_t i = 0; i < count; ++i) {
+                    bits |= std::uint64_t{cells[first + i] == target[k]} << i;
+                }
+                grid.planes[k][row * grid.wordsPerRow + word] = bits;
+            }
+        }
+    }
+    return grid;
+}
+
+inline std::uint64_t Day04::shiftedWord(const BitGrid &grid, const std::size_t plane, const std::size_t row,
+                                        const std::size_t word, const std::ptrdiff_t shift) noexcept {
+    const std::uint64_t *words = grid.planes[plane].data() + row * grid.wordsPerRow;
+    if (shift == 0) return words[word];
+    if (shift > 0) {
+        const auto s = static_cast<unsigned>(shift);
+        const std::uint64_t next = word + 1 < grid.wordsPerRow ? words[word + 1] : 0;
+        return (words[word] >> s) | (next << (64 - s));
+    }
+    const auto s = static_cast<unsigned>(-shift);
+    const std::uint64_t previous = word > 0 ? words[word - 1] : 0;
+    return (words[word] << s) | (previous >> (64 - s));
+}
+
+inline size_t Day04::countWordsBitboard(const BitGrid &grid) noexcept {
+    const auto length = static_cast<std::ptrdiff_t>(target.length());
+    const auto rows = static_cast<std::ptrdiff_t>(grid.rows);
+    size_t matches = 0;
+
+    for (const auto direction: directions) {
+        const auto [dx, dy] = decodeDirection(direction); // Row and column step
+        // Rows whose word stays inside the grid vertically
+        const std::ptrdiff_t firstRow = std::max<std::ptrdiff_t>(0, -dx * (length - 1));
+        const std::ptrdiff_t lastRow = std::min<std::ptrdiff_t>(rows, rows - dx * (length - 1));
+        for (std::ptrdiff_t row = firstRow; row < lastRow; ++row) {
+            for (size_t word = 0; word < grid.wordsPerRow; ++word) {
+                std::uint64_t found = grid.planes[0][static_cast<size_t>(row) * grid.wordsPerRow + word];
+                for (std::ptrdiff_t k = 1; k < length && found != 0; ++k) {
+                    found &= shiftedWord(grid, static_cast<size_t>(k), static_cast<size_t>(row + dx * k), word,
+                                         dy * k);
+                }
+                matches += static_cast<size_t>(std::popcount(found));
+            }
+        }
+    }
+    return matches;
+}
+
+inline size_t Day04::countCrossesBitboard(const BitGrid &grid) noexcept {
+    constexpr size_t M = 1; // Planes of target, "XMAS"
+    constexpr size_t A = 2;
+    constexpr size_t S = 3;
+    static_assert(target.substr(M, 3) == "MAS", "Crosses read the M, A and S planes of target");
+    size_t matches = 0;
+
+    for (size_t row = 1; row + 1 < grid.rows; ++row) {
+        for (size_t word = 0; word < grid.wordsPerRow; ++word) {
+            const auto at = [&](const size_t plane, const size_t r, const std::ptrdiff_t shift) {
+                return shiftedWord(grid, plane, r, word, shift);
+            };
+            const std::uint64_t centers = grid.planes[A][row * grid.wordsPerRow + word];
+            if (centers == 0) continue;
+            const std::uint64_t falling = (at(M, row - 1, -1) & at(S, row + 1, 1)) |
+                                          (at(S, row - 1, -1) & at(M, row + 1, 1));
+            const std::uint64_t rising = (at(M, row - 1, 1) & at(S, row + 1, -1)) |
+                                         (at(S, row - 1, 1) & at(M, row + 1, -1));
+            matches += static_cast<size_t>(std::popcount(centers & falling & rising));
+        }
+    }
+    return matches;
+}
@@ -6,10 +6,12 @@
 #include <print>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "AocExceptions.h"
 #include "AocTemplates.h"
+#include "Pattern.h"
 
 class Day05 {
 public:
@@ -24,6 +26,9 @@ public:
 #ifdef TESTING
     friend class Day05Test;
 #endif
+#ifdef BENCHMARKING
+    friend class Day05Bench;
+#endif
 
 private:
     // Core processing logic shared between both parts
@@ -51,6 +56,13 @@ private:
     static std::expected<std::unordered_map<int, std::unordered_set<int> >, aoc::exceptions::AocException>
     buildRuleMap(const std::string &filename);
 
+    using RulePattern = aoc::pattern::Matcher<R"(\d+|\d+)">;
+
+    // One "before|after" pair per line, blank lines skipped
+    template<aoc::templates::Numeric T>
+    static std::expected<std::vector<std::pair<T, T> >, aoc::exceptions::AocException> readRules(
+        const std::filesystem::path &path) noexcept;
+
     template<aoc::templates::Numeric T>
     static std::expected<std::vector<std::vector<T> >, aoc::exceptions::AocException> readLists(
         const std::filesystem::path &path, char splitter) noexcept;
@@ -158,19 +170,45 @@ constexpr auto Day05::fixList(std::vector<int> &update, const int targetIndex, c
 
 inline std::expected<std::unordered_map<int, std::unordered_set<int> >, aoc::exceptions::AocException> Day05::
 buildRuleMap(const std::string &filename) {
-    auto rules = readLists<int>(filename, '|');
+    auto rules = readRules<int>(filename);
     if (!rules) return std::unexpected(rules.error());
 
     std::unordered_map<int, std::unordered_set<int> > ruleMap;
-    for (const auto &rule: rules.value()) {
-        if (rule.size() != 2) {
-            return std::unexpected(aoc::exceptions::DataFormatError("Invalid rule format"));
-        }
-        ruleMap[rule[0]].insert(rule[1]);
+    for (const auto &[before, after]: rules.value()) {
+        ruleMap[before].insert(after);
     }
     return ruleMap;
 }
 
+template<aoc::templates::Numeric T>
+std::expected<std::vector<std::pair<T, T> >, aoc::exceptions::AocException> Day05::readRules(
+    const std::filesystem::path &path) noexcept {
+    auto stream = openFile(path);
+    if (!stream) {
+        return std::unexpected(stream.error());
+    }
+    std::vector<std::pair<T, T> > rules;
+
+    try {
+        std::string line;
+        while (std::getline(stream.value(), line)) {
+            std::string_view view{line};
+            if (view.ends_with('\r')) view.remove_suffix(1);
+            if (view.empty()) continue;
+
+            const auto rule = RulePattern::match<T>(view);
+            if (!rule) {
+                return std::unexpected(aoc::exceptions::DataFormatError("Invalid rule format"));
+            }
+            rules.emplace_back((*rule)[0], (*rule)[1]);
+        }
+    } catch (const std::exception &) {
+        return std::unexpected(aoc::exceptions::DataFormatError("Error reading rules"));
+    }
+
+    return rules;
+}
+
 template<aoc::templates::Numeric T>
 std::expected<std::vector<std::vector<T> >, aoc::exceptions::AocException> Day05::readLists(
     const std::filesystem::path &path, char splitter) noexcept {
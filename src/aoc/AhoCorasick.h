@@ -0,0 +1,173 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <queue>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "AocExceptions.h"
+
+namespace aoc {
+    // Aho-Corasick automaton: every occurrence of every word in one left-to-right pass over a text.
+    // Transitions are a full table over byte classes (one class per byte used by some word, plus one
+    // for all others), so next() is a single lookup and the text is never re-read.
+    class AhoCorasick {
+    public:
+        using State = std::uint32_t;
+
+        // Words are identified by their index in words; duplicates each report their own matches
+        static std::expected<AhoCorasick, aoc::exceptions::AocException> build(
+            std::span<const std::string_view> words) noexcept;
+
+        [[nodiscard]] static constexpr State start() noexcept { return 0; }
+
+        [[nodiscard]] State next(State state, char c) const noexcept;
+
+        // Calls visit(wordId) for every word ending at the position that led to state
+        template<typename F>
+        void forEachMatch(State state, F &&visit) const;
+
+        // Calls visit(wordId, endOffset) for every occurrence, endOffset one past the word's last byte
+        template<typename F>
+        void scan(std::string_view text, F &&visit) const;
+
+        [[nodiscard]] size_t wordCount() const noexcept;
+
+        [[nodiscard]] size_t wordLength(size_t wordId) const noexcept;
+
+        [[nodiscard]] size_t stateCount() const noexcept;
+
+    private:
+        static constexpr State NO_STATE = std::numeric_limits<State>::max();
+
+        AhoCorasick() = default;
+
+        [[nodiscard]] bool hasOutput(State state) const noexcept;
+
+        std::array<std::uint16_t, 256> byteClass{}; // 0 for bytes that appear in no word
+        size_t classes = 1;
+        std::vector<State> transitions; // State-major, stateCount() * classes
+        std::vector<State> dictionaryLink; // Longest proper suffix state with an output, NO_STATE if none
+        std::vector<std::uint32_t> firstOutput; // Words ending at s: outputs[firstOutput[s], firstOutput[s + 1])
+        std::vector<std::uint32_t> outputs;
+        std::vector<size_t> lengths;
+    };
+
+    inline std::expected<AhoCorasick, aoc::exceptions::AocException> AhoCorasick::build(
+        const std::span<const std::string_view> words) noexcept {
+        if (words.size() >= NO_STATE) {
+            return std::unexpected(aoc::exceptions::AlgorithmError("Too many words for the automaton"));
+        }
+        try {
+            AhoCorasick automaton;
+            for (const auto word: words) {
+                if (word.empty()) {
+                    return std::unexpected(aoc::exceptions::AlgorithmError("Dictionary words must not be empty"));
+                }
+                for (const char c: word) {
+                    auto &cls = automaton.byteClass[static_cast<std::uint8_t>(c)];
+                    if (cls == 0) cls = static_cast<std::uint16_t>(automaton.classes++);
+                }
+            }
+            const size_t classes = automaton.classes;
+            auto &transitions = automaton.transitions;
+
+            // Trie, with NO_STATE for missing edges
+            std::vector<std::vector<std::uint32_t> > ownWords(1);
+            transitions.assign(classes, NO_STATE);
+            for (size_t id = 0; id < words.size(); ++id) {
+                State state = start();
+                for (const char c: words[id]) {
+                    auto &edge = transitions[state * classes + automaton.byteClass[static_cast<std::uint8_t>(c)]];
+                    if (edge == NO_STATE) {
+                        if (ownWords.size() >= NO_STATE) {
+                            return std::unexpected(aoc::exceptions::AlgorithmError("Too many automaton states"));
+                        }
+                        edge = static_cast<State>(ownWords.size());
+                        ownWords.emplace_back();
+                        transitions.resize(transitions.size() + classes, NO_STATE);
+                    }
+                    state = transitions[state * classes + automaton.byteClass[static_cast<std::uint8_t>(c)]];
+                }
+                ownWords[state].push_back(static_cast<std::uint32_t>(id));
+                automaton.lengths.push_back(words[id].size());
+            }
+
+            auto &firstOutput = automaton.firstOutput;
+            firstOutput.reserve(ownWords.size() + 1);
+            firstOutput.push_back(0);
+            for (const auto &own: ownWords) {
+                automaton.outputs.insert(automaton.outputs.end(), own.begin(), own.end());
+                firstOutput.push_back(static_cast<std::uint32_t>(automaton.outputs.size()));
+            }
+
+            // Breadth first, so a state's failure target is complete before the state itself: missing edges
+            // become the failure target's edge, which turns the trie into a full transition table
+            std::vector<State> failure(ownWords.size(), start());
+            automaton.dictionaryLink.assign(ownWords.size(), NO_STATE);
+            std::queue<State> pending;
+            for (size_t cls = 0; cls < classes; ++cls) {
+                auto &edge = transitions[cls];
+                if (edge == NO_STATE) {
+                    edge = start();
+                } else {
+                    pending.push(edge);
+                }
+            }
+            while (!pending.empty()) {
+                const State state = pending.front();
+                pending.pop();
+                const State fail = failure[state];
+                automaton.dictionaryLink[state] = automaton.hasOutput(fail) ? fail : automaton.dictionaryLink[fail];
+                for (size_t cls = 0; cls < classes; ++cls) {
+                    auto &edge = transitions[state * classes + cls];
+                    if (edge == NO_STATE) {
+                        edge = transitions[fail * classes + cls];
+                    } else {
+                        failure[edge] = transitions[fail * classes + cls];
+                        pending.push(edge);
+                    }
+                }
+            }
+            return automaton;
+        } catch (const std::exception &) {
+            return std::unexpected(aoc::exceptions::AlgorithmError("Failed to allocate automaton"));
+        }
+    }
+
+    inline AhoCorasick::State AhoCorasick::next(const State state, const char c) const noexcept {
+        return transitions[state * classes + byteClass[static_cast<std::uint8_t>(c)]];
+    }
+
+    template<typename F>
+    void AhoCorasick::forEachMatch(const State state, F &&visit) const {
+        for (State s = hasOutput(state) ? state : dictionaryLink[state]; s != NO_STATE; s = dictionaryLink[s]) {
+            for (auto i = firstOutput[s]; i < firstOutput[s + 1]; ++i) {
+                visit(static_cast<size_t>(outputs[i]));
+            }
+        }
+    }
+
+    template<typename F>
+    void AhoCorasick::scan(const std::string_view text, F &&visit) const {
+        State state = start();
+        for (size_t i = 0; i < text.size(); ++i) {
+            state = next(state, text[i]);
+            forEachMatch(state, [&](const size_t wordId) { visit(wordId, i + 1); });
+        }
+    }
+
+    inline size_t AhoCorasick::wordCount() const noexcept { return lengths.size(); }
+
+    inline size_t AhoCorasick::wordLength(const size_t wordId) const noexcept { return lengths[wordId]; }
+
+    inline size_t AhoCorasick::stateCount() const noexcept { return dictionaryLink.size(); }
+
+    inline bool AhoCorasick::hasOutput(const State state) const noexcept {
+        return firstOutput[state] != firstOutput[state + 1];
+    }
+} // namespace aoc
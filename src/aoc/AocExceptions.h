@@ -17,6 +17,13 @@ namespace aoc::exceptions {
         }
     };
 
+    class FileWriteError final : public AocException {
+    public:
+        explicit FileWriteError(const std::string &filename)
+            : AocException("Failed to write file: " + filename) {
+        }
+    };
+
     class DataFormatError final : public AocException {
     public:
         explicit DataFormatError(const std::string &message)
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <concepts>
+#include <cstdint>
+#include <span>
 #include <type_traits>
 
 namespace aoc::templates {
@@ -17,4 +20,16 @@ namespace aoc::templates {
         { f(span) } -> std::convertible_to<bool>;
     };
 
+    // Compile-time rules for the step between two consecutive values, in either direction
+    template<typename P, typename T>
+    concept StepPolicy = Numeric<T> && requires(T a, T b)
+    {
+        { P::template validStep<true>(a, b) } -> std::convertible_to<bool>;
+        { P::template validStep<false>(a, b) } -> std::convertible_to<bool>;
+        { P::MIN_STEP } -> std::convertible_to<int64_t>;
+        { P::MAX_STEP } -> std::convertible_to<int64_t>;
+        { P::ALLOWS_INCREASING } -> std::convertible_to<bool>;
+        { P::ALLOWS_DECREASING } -> std::convertible_to<bool>;
+    };
+
 }
\ No newline at end of file
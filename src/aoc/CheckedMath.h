@@ -0,0 +1,51 @@
+#pragma once
+
+#include <concepts>
+#include <limits>
+#include <optional>
+
+namespace aoc::checked {
+    // Integer arithmetic that reports overflow as nullopt instead of wrapping or invoking undefined behaviour.
+    // Plain bound checks against std::numeric_limits, so every compiler takes them, constexpr included.
+
+    template<std::integral T>
+    [[nodiscard]] constexpr std::optional<T> add(const T a, const T b) noexcept {
+        constexpr T lowest = std::numeric_limits<T>::min();
+        constexpr T highest = std::numeric_limits<T>::max();
+        if constexpr (std::signed_integral<T>) {
+            if (b > 0 ? a > highest - b : a < lowest - b) return std::nullopt;
+        } else {
+            if (a > highest - b) return std::nullopt;
+        }
+        return static_cast<T>(a + b);
+    }
+
+    template<std::integral T>
+    [[nodiscard]] constexpr std::optional<T> sub(const T a, const T b) noexcept {
+        constexpr T lowest = std::numeric_limits<T>::min();
+        constexpr T highest = std::numeric_limits<T>::max();
+        if constexpr (std::signed_integral<T>) {
+            if (b < 0 ? a > highest + b : a < lowest + b) return std::nullopt;
+        } else {
+            if (a < b) return std::nullopt;
+        }
+        return static_cast<T>(a - b);
+    }
+
+    template<std::integral T>
+    [[nodiscard]] constexpr std::optional<T> mul(const T a, const T b) noexcept {
+        constexpr T lowest = std::numeric_limits<T>::min();
+        constexpr T highest = std::numeric_limits<T>::max();
+        if (a == 0 || b == 0) return T{0};
+        if constexpr (std::signed_integral<T>) {
+            // Dividing the bound by a positive factor never overflows, so pick that side per sign case
+            const bool overflows = a > 0
+                                       ? (b > 0 ? a > highest / b : b < lowest / a)
+                                       : (b > 0 ? a < lowest / b : b < highest / a);
+            if (overflows) return std::nullopt;
+        } else {
+            if (a > highest / b) return std::nullopt;
+        }
+        return static_cast<T>(a * b);
+    }
+} // namespace aoc::checked
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <vector>
+
+#include "AocExceptions.h"
+#include "AocTemplates.h"
+#include "CheckedMath.h"
+
+namespace aoc {
+    // Count-Min sketch: depth rows of width counters, each row indexed by its own hash of the key.
+    // With non-negative weights every estimate is an overestimate by at most epsilon() * totalWeight()
+    // with probability at least 1 - delta(), in memory fixed at construction.
+    template<aoc::templates::Numeric Counter = std::int64_t>
+    class CountMinSketch {
+    public:
+        CountMinSketch(size_t width, size_t depth, std::uint64_t seed = DEFAULT_SEED);
+
+        // Smallest sketch giving additive error epsilon * totalWeight() with probability 1 - delta
+        static std::expected<CountMinSketch, aoc::exceptions::AocException> withErrorBounds(
+            double epsilon, double delta, std::uint64_t seed = DEFAULT_SEED) noexcept;
+
+        void add(std::uint64_t key, Counter weight = Counter{1}) noexcept;
+
+        [[nodiscard]] Counter estimate(std::uint64_t key) const noexcept;
+
+        // Overestimate of sum over keys of f(key) * g(key); both sketches need the same shape and seed.
+        // Integer rows that overflow Counter are skipped, an error if every row does
+        [[nodiscard]] std::expected<Counter, aoc::exceptions::AocException> innerProduct(
+            const CountMinSketch &other) const noexcept;
+
+        [[nodiscard]] Counter totalWeight() const noexcept;
+
+        [[nodiscard]] double epsilon() const noexcept;
+
+        [[nodiscard]] double delta() const noexcept;
+
+        [[nodiscard]] size_t width() const noexcept;
+
+        [[nodiscard]] size_t depth() const noexcept;
+
+        [[nodiscard]] size_t memoryBytes() const noexcept;
+
+    private:
+        static constexpr std::uint64_t DEFAULT_SEED = 0x9E3779B97F4A7C15ULL;
+
+        [[nodiscard]] size_t column(size_t row, std::uint64_t key) const noexcept;
+
+        // splitmix64 finaliser, every output bit depends on every input bit
+        static constexpr std::uint64_t mix(std::uint64_t x) noexcept {
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            return x ^ (x >> 31);
+        }
+
+        size_t columns;
+        size_t rows;
+        std::uint64_t hashSeed;
+        std::vector<std::uint64_t> rowSeeds;
+        std::vector<Counter> counters; // Row-major, rows * columns
+        Counter total{0};
+    };
+
+    template<aoc::templates::Numeric Counter>
+    CountMinSketch<Counter>::CountMinSketch(const size_t width, const size_t depth, const std::uint64_t seed):
+        columns(std::max<size_t>(width, 1)), rows(std::max<size_t>(depth, 1)), hashSeed(seed), rowSeeds(rows),
+        counters(rows * columns, Counter{0}) {
+        for (size_t row = 0; row < rows; ++row) {
+            rowSeeds[row] = mix(seed + row * DEFAULT_SEED);
+        }
+    }
+
+    template<aoc::templates::Numeric Counter>
+    std::expected<CountMinSketch<Counter>, aoc::exceptions::AocException> CountMinSketch<Counter>::withErrorBounds(
+        const double epsilon, const double delta, const std::uint64_t seed) noexcept {
+        if (!(epsilon > 0.0 && epsilon < 1.0) || !(delta > 0.0 && delta < 1.0)) {
+            return std::unexpected(aoc::exceptions::AlgorithmError("Sketch error bounds must lie in (0, 1)"));
+        }
+        try {
+            const auto width = static_cast<size_t>(std::ceil(std::numbers::e / epsilon));
+            const auto depth = static_cast<size_t>(std::ceil(std::log(1.0 / delta)));
+            return CountMinSketch(width, depth, seed);
+        } catch (const std::exception &) {
+            return std::unexpected(aoc::exceptions::AlgorithmError("Failed to allocate sketch"));
+        }
+    }
+
+    template<aoc::templates::Numeric Counter>
+    void CountMinSketch<Counter>::add(const std::uint64_t key, const Counter weight) noexcept {
+        for (size_t row = 0; row < rows; ++row) {
+            counters[row * columns + column(row, key)] += weight;
+        }
+        total += weight;
+    }
+
+    template<aoc::templates::Numeric Counter>
+    Counter CountMinSketch<Counter>::estimate(const std::uint64_t key) const noexcept {
+        Counter best = std::numeric_limits<Counter>::max();
+        for (size_t row = 0; row < rows; ++row) {
+            best = std::min(best, counters[row * columns + column(row, key)]);
+        }
+        return best;
+    }
+
+    template<aoc::templates::Numeric Counter>
+    std::expected<Counter, aoc::exceptions::AocException> CountMinSketch<Counter>::innerProduct(
+        const CountMinSketch &other) const noexcept {
+        if (columns != other.columns || rows != other.rows || hashSeed != other.hashSeed) {
+            return std::unexpected(aoc::exceptions::AlgorithmError("Sketches do not share shape and seed"));
+        }
+        // Every row overestimates, so the tightest row wins; a row past the Counter range cannot be it
+        Counter best = std::numeric_limits<Counter>::max();
+        bool anyRow = false;
+        for (size_t row = 0; row < rows; ++row) {
+            Counter sum{0};
+            bool overflow = false;
+            for (size_t col = row * columns; col < (row + 1) * columns && !overflow; ++col) {
+                if constexpr (std::integral<Counter>) {
+                    const auto product = aoc::checked::mul(counters[col], other.counters[col]);
+                    const auto next = product ? aoc::checked::add(sum, *product) : std::nullopt;
+                    overflow = !next;
+                    sum = next.value_or(sum);
+                } else {
+                    sum += counters[col] * other.counters[col];
+                }
+            }
+            if (overflow) continue;
+            best = std::min(best, sum);
+            anyRow = true;
+        }
+        if (!anyRow) {
+            return std::unexpected(aoc::exceptions::AlgorithmError("Sketch inner product overflows the counter"));
+        }
+        return best;
+    }
+
+    template<aoc::templates::Numeric Counter>
+    Counter CountMinSketch<Counter>::totalWeight() const noexcept { return total; }
+
+    template<aoc::templates::Numeric Counter>
+    double CountMinSketch<Counter>::epsilon() const noexcept {
+        return std::numbers::e / static_cast<double>(columns);
+    }
+
+    template<aoc::templates::Numeric Counter>
+    double CountMinSketch<Counter>::delta() const noexcept { return std::exp(-static_cast<double>(rows)); }
+
+    template<aoc::templates::Numeric Counter>
+    size_t CountMinSketch<Counter>::width() const noexcept { return columns; }
+
+    template<aoc::templates::Numeric Counter>
+    size_t CountMinSketch<Counter>::depth() const noexcept { return rows; }
+
+    template<aoc::templates::Numeric Counter>
+    size_t CountMinSketch<Counter>::memoryBytes() const noexcept {
+        return counters.size() * sizeof(Counter) + rowSeeds.size() * sizeof(std::uint64_t);
+    }
+
+    template<aoc::templates::Numeric Counter>
+    size_t CountMinSketch<Counter>::column(const size_t row, const std::uint64_t key) const noexcept {
+        return static_cast<size_t>(mix(key ^ rowSeeds[row]) % columns);
+    }
+} // namespace aoc
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <expected>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "AocExceptions.h"
+#include "RadixSort.h"
+
+namespace aoc::sort {
+    // Owns a scratch directory for spilled runs and removes it with everything inside
+    class TempDirectory {
+    public:
+        static std::expected<TempDirectory, aoc::exceptions::AocException> create(
+            const std::filesystem::path &parent) noexcept;
+
+        TempDirectory(const TempDirectory &) = delete;
+
+        TempDirectory &operator=(const TempDirectory &) = delete;
+
+        TempDirectory(TempDirectory &&other) noexcept;
+
+        TempDirectory &operator=(TempDirectory &&other) noexcept;
+
+        ~TempDirectory();
+
+        [[nodiscard]] std::filesystem::path nextFile();
+
+    private:
+        explicit TempDirectory(std::filesystem::path path) noexcept;
+
+        std::filesystem::path directory;
+        size_t fileCounter = 0;
+    };
+
+    template<RadixSortable T>
+    std::expected<void, aoc::exceptions::AocException> writeRun(const std::filesystem::path &path,
+                                                                 std::span<const T> values) noexcept;
+
+    // Buffers values and spills them as sorted run files whenever the buffer is full
+    template<RadixSortable T>
+    class RunWriter {
+    public:
+        RunWriter(TempDirectory &spillDirectory, size_t runCapacity);
+
+        std::expected<void, aoc::exceptions::AocException> push(T value) noexcept;
+
+        // Spills whatever is left, releases the buffer and hands over the list of runs
+        std::expected<std::vector<std::filesystem::path>, aoc::exceptions::AocException> finish() noexcept;
+
+        // Memory held by the run buffer, zero once finished
+        [[nodiscard]] size_t bufferBytes() const noexcept;
+
+    private:
+        std::expected<void, aoc::exceptions::AocException> spill() noexcept;
+
+        TempDirectory *directory;
+        size_t capacity;
+        std::vector<T> buffer;
+        std::vector<std::filesystem::path> runs;
+    };
+
+    namespace detail {
+        // Buffered sequential reader over a single run file
+        template<RadixSortable T>
+        class RunReader {
+        public:
+            RunReader(std::ifstream input, size_t bufferElements);
+
+            // Returns false once the run is exhausted or the read failed
+            bool next(T &value);
+
+            [[nodiscard]] bool failed() const noexcept;
+
+        private:
+            bool refill();
+
+            std::ifstream stream;
+            std::vector<T> buffer;
+            size_t position = 0;
+            size_t filled = 0;
+            bool error = false;
+        };
+    } // namespace detail
+
+    // k-way merge over sorted runs, yields values in ascending order
+    template<RadixSortable T>
+    class RunMerger {
+    public:
+        static std::expected<RunMerger, aoc::exceptions::AocException> open(
+            std::span<const std::filesystem::path> runs, size_t bufferElements) noexcept;
+
+        [[nodiscard]] bool empty() const noexcept;
+
+        [[nodiscard]] T top() const noexcept;
+
+        void pop();
+
+        // True if any run could not be read completely
+        [[nodiscard]] bool failed() const noexcept;
+
+    private:
+        struct Cursor {
+            T value;
+            size_t run;
+
+            constexpr bool operator>(const Cursor &other) const noexcept { return value > other.value; }
+        };
+
+        RunMerger() = default;
+
+        std::vector<detail::RunReader<T> > readers;
+        std::vector<Cursor> heap;
+        bool error = false;
+    };
+
+    // Merges groups of runs into longer runs until at most maxFanIn remain
+    template<RadixSortable T>
+    std::expected<std::vector<std::filesystem::path>, aoc::exceptions::AocException> reduceRuns(
+        std::vector<std::filesystem::path> runs, TempDirectory &directory, size_t maxFanIn,
+        size_t bufferElements) noexcept;
+
+    inline std::expected<TempDirectory, aoc::exceptions::AocException> TempDirectory::create(
+        const std::filesystem::path &parent) noexcept {
+        const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        for (int attempt = 0; attempt < 16; ++attempt) {
+            auto path = parent / std::format("aoc-spill-{}-{}", stamp, attempt);
+            std::error_code ec;
+            if (std::filesystem::create_directories(path, ec)) {
+                return TempDirectory(std::move(path));
+            }
+        }
+        return std::unexpected(aoc::exceptions::FileWriteError(parent.string()));
+    }
+
+    inline TempDirectory::TempDirectory(std::filesystem::path path) noexcept: directory(std::move(path)) {
+    }
+
+    inline TempDirectory::TempDirectory(TempDirectory &&other) noexcept: directory(std::move(other.directory)),
+                                                                        fileCounter(other.fileCounter) {
+        other.directory.clear();
+    }
+
+    inline TempDirectory &TempDirectory::operator=(TempDirectory &&other) noexcept {
+        if (this != &other) {
+            std::swap(directory, other.directory);
+            std::swap(fileCounter, other.fileCounter);
+        }
+        return *this;
+    }
+
+    inline TempDirectory::~TempDirectory() {
+        if (!directory.empty()) {
+            std::error_code ec;
+            std::filesystem::remove_all(directory, ec);
+        }
+    }
+
+    inline std::filesystem::path TempDirectory::nextFile() {
+        return directory / std::format("run-{}.bin", fileCounter++);
+    }
+
+    template<RadixSortable T>
+    std::expected<void, aoc::exceptions::AocException> writeRun(const std::filesystem::path &path,
+                                                                 std::span<const T> values) noexcept {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return std::unexpected(aoc::exceptions::FileWriteError(path.string()));
+        }
+        out.write(reinterpret_cast<const char *>(values.data()),
+                  static_cast<std::streamsize>(values.size_bytes()));
+        if (!out) {
+            return std::unexpected(aoc::exceptions::FileWriteError(path.string()));
+        }
+        return {};
+    }
+
+    template<RadixSortable T>
+    RunWriter<T>::RunWriter(TempDirectory &spillDirectory, const size_t runCapacity): directory(&spillDirectory),
+        capacity(std::max<size_t>(runCapacity, 1)) {
+        buffer.reserve(capacity);
+    }
+
+    template<RadixSortable T>
+    std::expected<void, aoc::exceptions::AocException> RunWriter<T>::push(const T value) noexcept {
+        buffer.push_back(value); // Never reallocates, capacity is reserved up front
+        if (buffer.size() == capacity) {
+            return spill();
+        }
+        return {};
+    }
+
+    template<RadixSortable T>
+    std::expected<std::vector<std::filesystem::path>, aoc::exceptions::AocException>
+    RunWriter<T>::finish() noexcept {
+        if (!buffer.empty()) {
+            if (auto spilled = spill(); !spilled) {
+                return std::unexpected(spilled.error());
+            }
+        }
+        // clear() keeps the capacity, and the merge phases that follow are sized to the whole budget
+        std::vector<T>().swap(buffer);
+        return std::move(runs);
+    }
+
+    template<RadixSortable T>
+    size_t RunWriter<T>::bufferBytes() const noexcept { return buffer.capacity() * sizeof(T); }
+
+    template<RadixSortable T>
+    std::expected<void, aoc::exceptions::AocException> RunWriter<T>::spill() noexcept {
+        try {
+            parallelRadixSort<T>(buffer);
+            auto path = directory->nextFile();
+            if (auto written = writeRun<T>(path, buffer); !written) {
+                return std::unexpected(written.error());
+            }
+            runs.push_back(std::move(path));
+        } catch (const std::exception &) {
+            return std::unexpected(aoc::exceptions::AlgorithmError("Failed to spill sorted run"));
+        }
+        buffer.clear();
+        return {};
+    }
+
+    template<RadixSortable T>
+    detail::RunReader<T>::RunReader(std::ifstream input, const size_t bufferElements): stream(std::move(input)),
+        buffer(std::max<size_t>(bufferElements, 1)) {
+    }
+
+    template<RadixSortable T>
+    bool detail::RunReader<T>::next(T &value) {
+        if (position == filled && !refill()) return false;
+        value = buffer[position++];
+        return true;
+    }
+
+    template<RadixSortable T>
+    bool detail::RunReader<T>::failed() const noexcept { return error; }
+
+    template<RadixSortable T>
+    bool detail::RunReader<T>::refill() {
+        stream.read(reinterpret_cast<char *>(buffer.data()),
+                    static_cast<std::streamsize>(buffer.size() * sizeof(T)));
+        const auto bytes = static_cast<size_t>(stream.gcount());
+        // A run holding a partial value was not written by us
+        if (bytes % sizeof(T) != 0 || (!stream && !stream.eof())) {
+            error = true;
+        }
+        position = 0;
+        filled = bytes / sizeof(T);
+        return filled != 0;
+    }
+
+    template<RadixSortable T>
+    std::expected<RunMerger<T>, aoc::exceptions::AocException> RunMerger<T>::open(
+        std::span<const std::filesystem::path> runs, const size_t bufferElements) noexcept {
+        try {
+            RunMerger merger;
+            merger.readers.reserve(runs.size());
+            merger.heap.reserve(runs.size());
+            for (const auto &run: runs) {
+                std::ifstream stream(run, std::ios::binary);
+                if (!stream.is_open()) {
+                    return std::unexpected(aoc::exceptions::FileOpenError(run.string()));
+                }
+                merger.readers.emplace_back(std::move(stream), bufferElements);
+            }
+            for (size_t run = 0; run < merger.readers.size(); ++run) {
+                if (T value; merger.readers[run].next(value)) {
+                    merger.heap.push_back({value, run});
+                }
+                merger.error = merger.error || merger.readers[run].failed();
+            }
+            std::ranges::make_heap(merger.heap, std::greater{});
+            return merger;
+        } catch (const std::exception &) {
+            return std::unexpected(aoc::exceptions::AlgorithmError("Failed to open sorted runs"));
+        }
+    }
+
+    template<RadixSortable T>
+    bool RunMerger<T>::empty() const noexcept { return heap.empty(); }
+
+    template<RadixSortable T>
+    T RunMerger<T>::top() const noexcept { return heap.front().value; }
+
+    template<RadixSortable T>
+    void RunMerger<T>::pop() {
+        std::ranges::pop_heap(heap, std::greater{});
+        auto &cursor = heap.back();
+        if (auto &reader = readers[cursor.run]; reader.next(cursor.value)) {
+            std::ranges::push_heap(heap, std::greater{});
+        } else {
+            error = error || reader.failed();
+            heap.pop_back();
+        }
+    }
+
+    template<RadixSortable T>
+    bool RunMerger<T>::failed() const noexcept { return error; }
+
+    template<RadixSortable T>
+    std::expected<std::vector<std::filesystem::path>, aoc::exceptions::AocException> reduceRuns(
+        std::vector<std::filesystem::path> runs, TempDirectory &directory, const size_t maxFanIn,
+        const size_t bufferElements) noexcept {
+        const size_t fanIn = std::max<size_t>(maxFanIn, 2);
+        try {
+            while (runs.size() > fanIn) {
+                std::vector<std::filesystem::path> merged;
+                for (size_t first = 0; first < runs.size(); first += fanIn) {
+                    const auto group = std::span{runs}.subspan(first, std::min(fanIn, runs.size() - first));
+                    if (group.size() == 1) {
+                        merged.push_back(group.front());
+                        continue;
+                    }
+
+                    auto merger = RunMerger<T>::open(group, bufferElements);
+                    if (!merger) return std::unexpected(merger.error());
+
+                    // Output goes through a buffer of the same size as one input buffer
+                    auto path = directory.nextFile();
+                    std::vector<T> out;
+                    out.reserve(std::max<size_t>(bufferElements, 1));
+                    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+                    if (!stream.is_open()) {
+                        return std::unexpected(aoc::exceptions::FileWriteError(path.string()));
+                    }
+                    const auto flush = [&] {
+                        stream.write(reinterpret_cast<const char *>(out.data()),
+                                     static_cast<std::streamsize>(out.size() * sizeof(T)));
+                        out.clear();
+                    };
+                    for (; !merger->empty(); merger->pop()) {
+                        out.push_back(merger->top());
+                        if (out.size() == out.capacity()) flush();
+                    }
+                    flush();
+                    if (!stream || merger->failed()) {
+                        return std::unexpected(aoc::exceptions::FileWriteError(path.string()));
+                    }
+
+                    for (const auto &run: group) {
+                        std::filesystem::remove(run);
+                    }
+                    merged.push_back(std::move(path));
+                }
+                runs = std::move(merged);
+            }
+        } catch (const std::exception &) {
+            return std::unexpected(aoc::exceptions::AlgorithmError("Failed to merge sorted runs"));
+        }
+        return runs;
+    }
+} // namespace aoc::sort
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <vector>
+
+#include "AocTemplates.h"
+
+namespace aoc {
+    // Compressed sparse rows: every list lives back to back in one values array and row i is
+    // values[offsets[i], offsets[i + 1]), so a whole input costs two allocations instead of one per row
+    template<aoc::templates::Numeric T>
+    class FlatLists {
+    public:
+        class Iterator;
+
+        FlatLists() = default;
+
+        FlatLists(std::initializer_list<std::initializer_list<T> > rows);
+
+        void reserve(size_t valueCount, size_t rowCount);
+
+        // Appends to the row being built, endRow() closes it
+        void push(T value);
+
+        void endRow();
+
+        void pushRow(std::span<const T> row);
+
+        [[nodiscard]] std::span<const T> operator[](size_t row) const noexcept;
+
+        [[nodiscard]] size_t size() const noexcept;
+
+        [[nodiscard]] bool empty() const noexcept;
+
+        [[nodiscard]] std::span<const T> values() const noexcept;
+
+        // size() + 1 entries, the last one is values().size()
+        [[nodiscard]] std::span<const size_t> offsets() const noexcept;
+
+        [[nodiscard]] Iterator begin() const noexcept;
+
+        [[nodiscard]] Iterator end() const noexcept;
+
+    private:
+        std::vector<T> data;
+        std::vector<size_t> rowStarts{0};
+    };
+
+    template<aoc::templates::Numeric T>
+    class FlatLists<T>::Iterator {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag; // Rows are produced by value
+        using value_type = std::span<const T>;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        Iterator(const FlatLists *lists, const size_t row) noexcept: owner(lists), index(row) {
+        }
+
+        value_type operator*() const noexcept { return (*owner)[index]; }
+
+        value_type operator[](const difference_type n) const noexcept {
+            return (*owner)[static_cast<size_t>(static_cast<difference_type>(index) + n)];
+        }
+
+        Iterator &operator++() noexcept {
+            ++index;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept { return {owner, index++}; }
+
+        Iterator &operator--() noexcept {
+            --index;
+            return *this;
+        }
+
+        Iterator operator--(int) noexcept { return {owner, index--}; }
+
+        Iterator &operator+=(const difference_type n) noexcept {
+            index = static_cast<size_t>(static_cast<difference_type>(index) + n);
+            return *this;
+        }
+
+        Iterator &operator-=(const difference_type n) noexcept { return *this += -n; }
+
+        friend Iterator operator+(Iterator it, const difference_type n) noexcept { return it += n; }
+
+        friend Iterator operator+(const difference_type n, Iterator it) noexcept { return it += n; }
+
+        friend Iterator operator-(Iterator it, const difference_type n) noexcept { return it -= n; }
+
+        friend difference_type operator-(const Iterator &a, const Iterator &b) noexcept {
+            return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+        }
+
+        friend bool operator==(const Iterator &a, const Iterator &b) noexcept { return a.index == b.index; }
+
+        friend auto operator<=>(const Iterator &a, const Iterator &b) noexcept { return a.index <=> b.index; }
+
+    private:
+        const FlatLists *owner = nullptr;
+        size_t index = 0;
+    };
+
+    template<aoc::templates::Numeric T>
+    FlatLists<T>::FlatLists(std::initializer_list<std::initializer_list<T> > rows) {
+        rowStarts.reserve(rows.size() + 1);
+        for (const auto &row: rows) {
+            pushRow(std::span<const T>{row.begin(), row.size()});
+        }
+    }
+
+    template<aoc::templates::Numeric T>
+    void FlatLists<T>::reserve(const size_t valueCount, const size_t rowCount) {
+        data.reserve(valueCount);
+        rowStarts.reserve(rowCount + 1);
+    }
+
+    template<aoc::templates::Numeric T>
+    void FlatLists<T>::push(const T value) { data.push_back(value); }
+
+    template<aoc::templates::Numeric T>
+    void FlatLists<T>::endRow() { rowStarts.push_back(data.size()); }
+
+    template<aoc::templates::Numeric T>
+    void FlatLists<T>::pushRow(std::span<const T> row) {
+        data.insert(data.end(), row.begin(), row.end());
+        endRow();
+    }
+
+    template<aoc::templates::Numeric T>
+    std::span<const T> FlatLists<T>::operator[](const size_t row) const noexcept {
+        return std::span<const T>{data}.subspan(rowStarts[row], rowStarts[row + 1] - rowStarts[row]);
+    }
+
+    template<aoc::templates::Numeric T>
+    size_t FlatLists<T>::size() const noexcept { return rowStarts.size() - 1; }
+
+    template<aoc::templates::Numeric T>
+    bool FlatLists<T>::empty() const noexcept { return size() == 0; }
+
+    template<aoc::templates::Numeric T>
+    std::span<const T> FlatLists<T>::values() const noexcept { return data; }
+
+    template<aoc::templates::Numeric T>
+    std::span<const size_t> FlatLists<T>::offsets() const noexcept { return rowStarts; }
+
+    template<aoc::templates::Numeric T>
+    typename FlatLists<T>::Iterator FlatLists<T>::begin() const noexcept { return {this, 0}; }
+
+    template<aoc::templates::Numeric T>
+    typename FlatLists<T>::Iterator FlatLists<T>::end() const noexcept { return {this, size()}; }
+} // namespace aoc
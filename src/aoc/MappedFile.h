@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "AocExceptions.h"
+
+namespace aoc {
+    // Read-only memory mapping of a whole file, unmapped on destruction
+    class MappedFile {
+    public:
+        static std::expected<MappedFile, aoc::exceptions::AocException> open(
+            const std::filesystem::path &path) noexcept;
+
+        MappedFile(const MappedFile &) = delete;
+
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&other) noexcept;
+
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+        ~MappedFile();
+
+        [[nodiscard]] std::span<const std::byte> bytes() const noexcept;
+
+    private:
+        MappedFile(const void *address, size_t length) noexcept;
+
+        void release() noexcept;
+
+        const void *data = nullptr;
+        size_t size = 0;
+    };
+
+    inline std::expected<MappedFile, aoc::exceptions::AocException> MappedFile::open(
+        const std::filesystem::path &path) noexcept {
+        std::error_code ec;
+        const auto length = static_cast<size_t>(std::filesystem::file_size(path, ec));
+        if (ec) {
+            return std::unexpected(aoc::exceptions::FileOpenError(path.string()));
+        }
+        if (length == 0) {
+            return MappedFile(nullptr, 0); // Mapping zero bytes is an error on every platform
+        }
+
+#ifdef _WIN32
+        const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return std::unexpected(aoc::exceptions::FileOpenError(path.string()));
+        }
+        const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr) {
+            return std::unexpected(aoc::exceptions::FileOpenError(path.string()));
+        }
+        const void *address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, length);
+        CloseHandle(mapping); // The view keeps the mapping alive
+        if (address == nullptr) {
+            return std::unexpected(aoc::exceptions::FileOpenError(path.string()));
+        }
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return std::unexpected(aoc::exceptions::FileOpenError(path.string()));
+        }
+        void *address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // The mapping keeps the file alive
+        if (address == MAP_FAILED) {
+            return std::unexpected(aoc::exceptions::FileOpenError(path.string()));
+        }
+        madvise(address, length, MADV_SEQUENTIAL);
+#endif
+        return MappedFile(address, length);
+    }
+
+    inline MappedFile::MappedFile(const void *address, const size_t length) noexcept: data(address), size(length) {
+    }
+
+    inline MappedFile::MappedFile(MappedFile &&other) noexcept: data(std::exchange(other.data, nullptr)),
+                                                                size(std::exchange(other.size, 0)) {
+    }
+
+    inline MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+        if (this != &other) {
+            release();
+            data = std::exchange(other.data, nullptr);
+            size = std::exchange(other.size, 0);
+        }
+        return *this;
+    }
+
+    inline MappedFile::~MappedFile() { release(); }
+
+    inline std::span<const std::byte> MappedFile::bytes() const noexcept {
+        return {static_cast<const std::byte *>(data), size};
+    }
+
+    inline void MappedFile::release() noexcept {
+        if (data == nullptr) return;
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+#else
+        munmap(const_cast<void *>(data), size);
+#endif
+        data = nullptr;
+        size = 0;
+    }
+} // namespace aoc
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "AocTemplates.h"
+
+namespace aoc::pattern {
+    // String literal usable as a template argument: Matcher<R"(mul(\d{1,3},\d{1,3}))">
+    template<size_t N>
+    struct FixedString {
+        std::array<char, N> chars{};
+
+        constexpr FixedString(const char (&text)[N]) noexcept { // NOLINT(*-explicit-constructor)
+            std::copy_n(text, N, chars.begin());
+        }
+
+        [[nodiscard]] constexpr std::string_view view() const noexcept { return {chars.data(), N - 1}; }
+    };
+
+    namespace detail {
+        constexpr size_t UNBOUNDED = std::numeric_limits<size_t>::max();
+
+        enum class Kind : uint8_t { Literal, Digits };
+
+        struct Element {
+            Kind kind = Kind::Literal;
+            char literal = 0;
+            size_t minDigits = 0;
+            size_t maxDigits = 0;
+        };
+
+        consteval size_t parseNumber(const std::string_view text, size_t &pos) {
+            if (pos >= text.size() || text[pos] < '0' || text[pos] > '9') throw "Expected a number in quantifier";
+            size_t value = 0;
+            while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+                value = value * 10 + static_cast<size_t>(text[pos++] - '0');
+            }
+            return value;
+        }
+
+        // Reads the element at text[pos] and moves pos past it. Malformed patterns throw, which is
+        // a compile error since this only runs at compile time.
+        consteval Element parseElement(const std::string_view text, size_t &pos) {
+            if (text[pos] != '\\') {
+                return {Kind::Literal, text[pos++], 0, 0};
+            }
+            if (++pos >= text.size()) throw "Pattern ends with an escape";
+            if (text[pos] != 'd') {
+                return {Kind::Literal, text[pos++], 0, 0};
+            }
+            ++pos;
+            Element digits{Kind::Digits, 0, 1, 1};
+            if (pos < text.size() && text[pos] == '+') {
+                digits.maxDigits = UNBOUNDED;
+                ++pos;
+            } else if (pos < text.size() && text[pos] == '{') {
+                ++pos;
+                digits.minDigits = digits.maxDigits = parseNumber(text, pos);
+                if (pos < text.size() && text[pos] == ',') {
+                    ++pos;
+                    digits.maxDigits = parseNumber(text, pos);
+                }
+                if (pos >= text.size() || text[pos] != '}') throw "Unterminated quantifier";
+                ++pos;
+            }
+            if (digits.minDigits == 0 || digits.minDigits > digits.maxDigits) throw "Digit runs take 1 or more digits";
+            return digits;
+        }
+
+        template<FixedString Pattern>
+        consteval size_t elementCount() {
+            size_t count = 0;
+            for (size_t pos = 0; pos < Pattern.view().size(); ++count) {
+                parseElement(Pattern.view(), pos);
+            }
+            return count;
+        }
+
+        template<FixedString Pattern>
+        consteval auto parse() {
+            std::array<Element, elementCount<Pattern>()> elements{};
+            size_t pos = 0;
+            for (auto &element: elements) {
+                element = parseElement(Pattern.view(), pos);
+            }
+            // Greedy runs never give digits back, which is only exact if no digit can follow a run
+            for (size_t i = 0; i + 1 < elements.size(); ++i) {
+                const auto &next = elements[i + 1];
+                if (elements[i].kind == Kind::Digits &&
+                    (next.kind == Kind::Digits || (next.literal >= '0' && next.literal <= '9'))) {
+                    throw "A digit run must not be followed by another digit";
+                }
+            }
+            return elements;
+        }
+    } // namespace detail
+
+    // Pattern compiled at compile time into one inlined check per element. Supported syntax: \d, \d+, \d{n}
+    // and \d{m,n} digit runs, each one a capture; \x for a literal x; any other character matches itself.
+    template<FixedString Pattern>
+    class Matcher {
+    public:
+        static constexpr auto ELEMENTS = detail::parse<Pattern>();
+
+        static constexpr size_t CAPTURES = static_cast<size_t>(std::ranges::count_if(
+            ELEMENTS, [](const detail::Element &element) { return element.kind == detail::Kind::Digits; }));
+
+        // Longest possible match, detail::UNBOUNDED if a run has no upper bound
+        static constexpr size_t MAX_LENGTH = [] {
+            size_t length = 0;
+            for (const auto &element: ELEMENTS) {
+                if (element.kind == detail::Kind::Literal) {
+                    ++length;
+                } else if (element.maxDigits == detail::UNBOUNDED) {
+                    return detail::UNBOUNDED;
+                } else {
+                    length += element.maxDigits;
+                }
+            }
+            return length;
+        }();
+
+        template<aoc::templates::Numeric T>
+        using Captures = std::array<T, CAPTURES>;
+
+        // Length of the match at the start of text, 0 if there is none. Captures are written in order;
+        // a run too large for T does not match.
+        template<aoc::templates::Numeric T>
+        static constexpr size_t matchPrefix(std::string_view text, Captures<T> &captures) noexcept;
+
+        static constexpr size_t matchPrefix(std::string_view text) noexcept requires (CAPTURES == 0);
+
+        // Captures if the whole text matches
+        template<aoc::templates::Numeric T>
+        static constexpr std::optional<Captures<T> > match(std::string_view text) noexcept;
+
+    private:
+        template<size_t I, aoc::templates::Numeric T>
+        static constexpr bool step(std::string_view text, size_t &pos, Captures<T> &captures) noexcept;
+
+        static consteval size_t captureIndex(const size_t element) {
+            size_t index = 0;
+            for (size_t i = 0; i < element; ++i) {
+                index += ELEMENTS[i].kind == detail::Kind::Digits ? 1 : 0;
+            }
+            return index;
+        }
+    };
+
+    template<FixedString Pattern>
+    template<aoc::templates::Numeric T>
+    constexpr size_t Matcher<Pattern>::matchPrefix(const std::string_view text, Captures<T> &captures) noexcept {
+        size_t pos = 0;
+        const bool matched = [&]<size_t... I>(std::index_sequence<I...>) {
+            return (step<I, T>(text, pos, captures) && ...);
+        }(std::make_index_sequence<ELEMENTS.size()>{});
+        return matched ? pos : 0;
+    }
+
+    template<FixedString Pattern>
+    constexpr size_t Matcher<Pattern>::matchPrefix(const std::string_view text) noexcept requires (CAPTURES == 0) {
+        Captures<int> none{};
+        return matchPrefix<int>(text, none);
+    }
+
+    template<FixedString Pattern>
+    template<aoc::templates::Numeric T>
+    constexpr std::optional<typename Matcher<Pattern>::template Captures<T> > Matcher<Pattern>::match(
+        const std::string_view text) noexcept {
+        Captures<T> captures{};
+        if (text.empty() || matchPrefix<T>(text, captures) != text.size()) return std::nullopt;
+        return captures;
+    }
+
+    template<FixedString Pattern>
+    template<size_t I, aoc::templates::Numeric T>
+    constexpr bool Matcher<Pattern>::step(const std::string_view text, size_t &pos, Captures<T> &captures) noexcept {
+        constexpr detail::Element ELEMENT = ELEMENTS[I];
+        if constexpr (ELEMENT.kind == detail::Kind::Literal) {
+            if (pos >= text.size() || text[pos] != ELEMENT.literal) return false;
+            ++pos;
+            return true;
+        } else {
+            const size_t first = pos;
+            T value{0};
+            while (pos < text.size() && pos - first < ELEMENT.maxDigits && text[pos] >= '0' && text[pos] <= '9') {
+                const auto digit = static_cast<T>(text[pos] - '0');
+                if constexpr (std::integral<T>) {
+                    if (value > static_cast<T>((std::numeric_limits<T>::max() - digit) / 10)) return false;
+                }
+                value = static_cast<T>(value * 10 + digit);
+                ++pos;
+            }
+            if (pos - first < ELEMENT.minDigits) return false;
+            captures[captureIndex(I)] = value;
+            return true;
+        }
+    }
+
+    // Shorthands for one-off matches: if (auto rule = aoc::pattern::match<R"(\d+|\d+)", int>(line))
+    template<FixedString Pattern, aoc::templates::Numeric T>
+    constexpr auto match(const std::string_view text) noexcept { return Matcher<Pattern>::template match<T>(text); }
+} // namespace aoc::pattern
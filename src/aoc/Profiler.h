@@ -19,5 +19,19 @@ namespace aoc {
             }
             return total / runs;
         }
+
+        // Same as profile, but setup runs untimed before every run (e.g. to restore unsorted input)
+        template<typename Setup, typename Func>
+        static auto profileWithSetup(Setup &&setup, Func &&f, const size_t runs) {
+            auto total = std::chrono::nanoseconds(0);
+            for (size_t i = 0; i < runs; ++i) {
+                setup();
+                auto start = std::chrono::steady_clock::now();
+                f();
+                auto end = std::chrono::steady_clock::now();
+                total += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+            }
+            return total / runs;
+        }
     };
 }
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <execution>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include "AocTemplates.h"
+
+namespace aoc::sort {
+    template<typename T>
+    concept RadixSortable = aoc::templates::Numeric<T> && sizeof(T) <= sizeof(std::uint64_t);
+
+    namespace detail {
+        constexpr std::size_t RADIX_BITS = 8;
+        constexpr std::size_t RADIX = std::size_t{1} << RADIX_BITS;
+        constexpr std::size_t MIN_PARALLEL_BLOCK = std::size_t{1} << 16;
+
+        template<std::size_t Size>
+        struct UnsignedOfSize;
+
+        template<>
+        struct UnsignedOfSize<1> { using type = std::uint8_t; };
+
+        template<>
+        struct UnsignedOfSize<2> { using type = std::uint16_t; };
+
+        template<>
+        struct UnsignedOfSize<4> { using type = std::uint32_t; };
+
+        template<>
+        struct UnsignedOfSize<8> { using type = std::uint64_t; };
+
+        template<RadixSortable T>
+        using KeyType = typename UnsignedOfSize<sizeof(T)>::type;
+
+        template<RadixSortable T>
+        constexpr std::size_t PASSES = sizeof(T);
+
+        using Histogram = std::array<std::size_t, RADIX>;
+
+        // Maps a value to an unsigned key with the same ordering
+        template<RadixSortable T>
+        constexpr KeyType<T> toKey(const T value) noexcept {
+            using Key = KeyType<T>;
+            constexpr Key SIGN_BIT = Key{1} << (sizeof(Key) * 8 - 1);
+
+            const auto bits = std::bit_cast<Key>(value);
+            if constexpr (std::is_floating_point_v<T>) {
+                // Negative floats order reversed, so flip every bit; positives only need the sign bit set
+                return (bits & SIGN_BIT) != 0 ? static_cast<Key>(~bits) : static_cast<Key>(bits | SIGN_BIT);
+            } else if constexpr (std::is_signed_v<T>) {
+                return static_cast<Key>(bits ^ SIGN_BIT);
+            } else {
+                return bits;
+            }
+        }
+
+        template<RadixSortable T>
+        constexpr std::size_t digitOf(const T value, const std::size_t pass) noexcept {
+            return static_cast<std::size_t>(toKey(value) >> (pass * RADIX_BITS)) & (RADIX - 1);
+        }
+
+        // Turns digit counts into starting offsets, returns false if the pass would not move anything
+        inline bool exclusiveScan(Histogram &counts, const std::size_t total, const std::size_t firstDigit) noexcept {
+            if (counts[firstDigit] == total) return false;
+            std::size_t running = 0;
+            for (auto &count: counts) {
+                running += std::exchange(count, running);
+            }
+            return true;
+        }
+    } // namespace detail
+
+    template<RadixSortable T>
+    void radixSort(std::span<T> values) {
+        const std::size_t n = values.size();
+        if (n < 2) return;
+
+        // All digit histograms are gathered in a single pass over the input
+        std::array<detail::Histogram, detail::PASSES<T> > counts{};
+        for (const T value: values) {
+            for (std::size_t pass = 0; pass < detail::PASSES<T>; ++pass) {
+                ++counts[pass][detail::digitOf(value, pass)];
+            }
+        }
+
+        std::vector<T> buffer(n);
+        std::span<T> src = values;
+        std::span<T> dst{buffer};
+
+        for (std::size_t pass = 0; pass < detail::PASSES<T>; ++pass) {
+            auto &offsets = counts[pass];
+            if (!detail::exclusiveScan(offsets, n, detail::digitOf(src[0], pass))) continue;
+
+            for (const T value: src) {
+                dst[offsets[detail::digitOf(value, pass)]++] = value;
+            }
+            std::swap(src, dst);
+        }
+
+        if (src.data() != values.data()) {
+            std::ranges::copy(src, values.begin());
+        }
+    }
+
+    template<RadixSortable T>
+    void parallelRadixSort(std::span<T> values) {
+        const std::size_t n = values.size();
+        if (n < 2) return;
+
+        // A few blocks per thread keeps the scatter balanced without blowing up the histogram table
+        const auto threads = static_cast<std::size_t>(tbb::this_task_arena::max_concurrency());
+        const std::size_t blockSize = std::max(detail::MIN_PARALLEL_BLOCK, (n + threads * 4 - 1) / (threads * 4));
+        const std::size_t blocks = (n + blockSize - 1) / blockSize;
+
+        std::vector<T> buffer(n);
+        std::span<T> src = values;
+        std::span<T> dst{buffer};
+        std::vector<detail::Histogram> histograms(blocks);
+
+        for (std::size_t pass = 0; pass < detail::PASSES<T>; ++pass) {
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, blocks), [&](const auto &range) {
+                for (std::size_t block = range.begin(); block != range.end(); ++block) {
+                    auto &histogram = histograms[block];
+                    histogram.fill(0);
+                    const std::size_t end = std::min(n, (block + 1) * blockSize);
+                    for (std::size_t i = block * blockSize; i < end; ++i) {
+                        ++histogram[detail::digitOf(src[i], pass)];
+                    }
+                }
+            });
+
+            // Offsets are laid out digit-major, block-minor so every block scatters stably
+            const std::size_t firstDigit = detail::digitOf(src[0], pass);
+            std::size_t firstDigitCount = 0;
+            std::size_t running = 0;
+            for (std::size_t digit = 0; digit < detail::RADIX; ++digit) {
+                for (auto &histogram: histograms) {
+                    if (digit == firstDigit) firstDigitCount += histogram[digit];
+                    running += std::exchange(histogram[digit], running);
+                }
+            }
+            if (firstDigitCount == n) continue;
+
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, blocks), [&](const auto &range) {
+                for (std::size_t block = range.begin(); block != range.end(); ++block) {
+                    auto &offsets = histograms[block];
+                    const std::size_t end = std::min(n, (block + 1) * blockSize);
+                    for (std::size_t i = block * blockSize; i < end; ++i) {
+                        dst[offsets[detail::digitOf(src[i], pass)]++] = src[i];
+                    }
+                }
+            });
+            std::swap(src, dst);
+        }
+
+        if (src.data() != values.data()) {
+            std::copy(std::execution::par_unseq, src.begin(), src.end(), values.begin());
+        }
+    }
+} // namespace aoc::sort
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <numeric>
+#include <span>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "AocTemplates.h"
+
+namespace aoc::simd {
+    // Element types with hand written kernels, everything else goes through std::transform_reduce
+    template<typename T>
+    concept SimdInteger = std::same_as<T, std::int32_t> || std::same_as<T, std::int64_t>;
+
+    // Named operations so callers can be routed to the kernels at compile time
+    struct AbsoluteDifference {
+        template<aoc::templates::Numeric T>
+        constexpr T operator()(const T a, const T b) const noexcept { return a > b ? a - b : b - a; }
+    };
+
+    struct Product {
+        template<aoc::templates::Numeric T>
+        constexpr T operator()(const T a, const T b) const noexcept { return a * b; }
+    };
+
+    // Elements per task of the chunked variants, large enough to amortise scheduling
+    constexpr std::size_t PARALLEL_CHUNK = std::size_t{1} << 16;
+
+    template<SimdInteger T>
+    [[nodiscard]] T sumAbsDiff(std::span<const T> a, std::span<const T> b) noexcept;
+
+    template<SimdInteger T>
+    [[nodiscard]] T sumProducts(std::span<const T> a, std::span<const T> b) noexcept;
+
+    template<SimdInteger T>
+    [[nodiscard]] T parallelSumAbsDiff(std::span<const T> a, std::span<const T> b);
+
+    template<SimdInteger T>
+    [[nodiscard]] T parallelSumProducts(std::span<const T> a, std::span<const T> b);
+
+    namespace detail {
+        template<SimdInteger T, typename Op>
+        T scalarReduce(std::span<const T> a, std::span<const T> b, Op op) noexcept {
+            return std::transform_reduce(std::execution::unseq, a.begin(), a.end(), b.begin(), T{0}, std::plus{}, op);
+        }
+
+        template<SimdInteger T, typename Kernel>
+        T chunkedReduce(std::span<const T> a, std::span<const T> b, Kernel kernel) {
+            return tbb::parallel_reduce(
+                tbb::blocked_range<std::size_t>(0, a.size(), PARALLEL_CHUNK),
+                T{0},
+                [a, b, kernel](const auto &range, const T partial) {
+                    const auto count = range.end() - range.begin();
+                    return partial + kernel(a.subspan(range.begin(), count), b.subspan(range.begin(), count));
+                },
+                std::plus{}
+            );
+        }
+
+#if defined(__AVX512F__)
+        inline __m512i load512(const void *ptr) noexcept { return _mm512_loadu_si512(ptr); }
+
+        inline std::int64_t sumAbsDiff512(const std::int64_t *a, const std::int64_t *b, std::size_t &i,
+                                          const std::size_t n) noexcept {
+            __m512i acc0 = _mm512_setzero_si512();
+            __m512i acc1 = _mm512_setzero_si512();
+            for (; i + 16 <= n; i += 16) {
+                acc0 = _mm512_add_epi64(acc0, _mm512_abs_epi64(_mm512_sub_epi64(load512(a + i), load512(b + i))));
+                acc1 = _mm512_add_epi64(acc1, _mm512_abs_epi64(
+                                            _mm512_sub_epi64(load512(a + i + 8), load512(b + i + 8))));
+            }
+            return _mm512_reduce_add_epi64(_mm512_add_epi64(acc0, acc1));
+        }
+
+        inline std::int32_t sumAbsDiff512(const std::int32_t *a, const std::int32_t *b, std::size_t &i,
+                                          const std::size_t n) noexcept {
+            __m512i acc0 = _mm512_setzero_si512();
+            __m512i acc1 = _mm512_setzero_si512();
+            for (; i + 32 <= n; i += 32) {
+                acc0 = _mm512_add_epi32(acc0, _mm512_abs_epi32(_mm512_sub_epi32(load512(a + i), load512(b + i))));
+                acc1 = _mm512_add_epi32(acc1, _mm512_abs_epi32(
+                                            _mm512_sub_epi32(load512(a + i + 16), load512(b + i + 16))));
+            }
+            return _mm512_reduce_add_epi32(_mm512_add_epi32(acc0, acc1));
+        }
+
+#if defined(__AVX512DQ__)
+        inline std::int64_t sumProducts512(const std::int64_t *a, const std::int64_t *b, std::size_t &i,
+                                           const std::size_t n) noexcept {
+            __m512i acc = _mm512_setzero_si512();
+            for (; i + 8 <= n; i += 8) {
+                acc = _mm512_add_epi64(acc, _mm512_mullo_epi64(load512(a + i), load512(b + i)));
+            }
+            return _mm512_reduce_add_epi64(acc);
+        }
+#endif
+
+        inline std::int32_t sumProducts512(const std::int32_t *a, const std::int32_t *b, std::size_t &i,
+                                           const std::size_t n) noexcept {
+            __m512i acc = _mm512_setzero_si512();
+            for (; i + 16 <= n; i += 16) {
+                acc = _mm512_add_epi32(acc, _mm512_mullo_epi32(load512(a + i), load512(b + i)));
+            }
+            return _mm512_reduce_add_epi32(acc);
+        }
+#endif
+
+#if defined(__AVX2__)
+        inline __m256i load256(const void *ptr) noexcept {
+            return _mm256_loadu_si256(static_cast<const __m256i *>(ptr));
+        }
+
+        inline std::int64_t horizontalSum64(const __m256i v) noexcept {
+            const __m128i pair = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+            return _mm_cvtsi128_si64(_mm_add_epi64(pair, _mm_unpackhi_epi64(pair, pair)));
+        }
+
+        inline std::int32_t horizontalSum32(const __m256i v) noexcept {
+            __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+            sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+            sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtsi128_si32(sum);
+        }
+
+        // AVX2 has no 64-bit abs, so flip negative lanes with their sign mask: (d ^ m) - m
+        inline __m256i absDiff64(const __m256i a, const __m256i b) noexcept {
+            const __m256i diff = _mm256_sub_epi64(a, b);
+            const __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), diff);
+            return _mm256_sub_epi64(_mm256_xor_si256(diff, sign), sign);
+        }
+
+        // Low 64 bits of a 64x64 product from three 32x32 multiplies
+        inline __m256i mullo64(const __m256i a, const __m256i b) noexcept {
+            const __m256i low = _mm256_mul_epu32(a, b);
+            const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                                   _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+            return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+        }
+
+        inline std::int64_t sumAbsDiff256(const std::int64_t *a, const std::int64_t *b, std::size_t &i,
+                                          const std::size_t n) noexcept {
+            __m256i acc0 = _mm256_setzero_si256();
+            __m256i acc1 = _mm256_setzero_si256();
+            for (; i + 8 <= n; i += 8) {
+                acc0 = _mm256_add_epi64(acc0, absDiff64(load256(a + i), load256(b + i)));
+                acc1 = _mm256_add_epi64(acc1, absDiff64(load256(a + i + 4), load256(b + i + 4)));
+            }
+            return horizontalSum64(_mm256_add_epi64(acc0, acc1));
+        }
+
+        inline std::int32_t sumAbsDiff256(const std::int32_t *a, const std::int32_t *b, std::size_t &i,
+                                          const std::size_t n) noexcept {
+            __m256i acc0 = _mm256_setzero_si256();
+            __m256i acc1 = _mm256_setzero_si256();
+            for (; i + 16 <= n; i += 16) {
+                acc0 = _mm256_add_epi32(acc0, _mm256_abs_epi32(_mm256_sub_epi32(load256(a + i), load256(b + i))));
+                acc1 = _mm256_add_epi32(acc1, _mm256_abs_epi32(
+                                            _mm256_sub_epi32(load256(a + i + 8), load256(b + i + 8))));
+            }
+            return horizontalSum32(_mm256_add_epi32(acc0, acc1));
+        }
+
+        inline std::int64_t sumProducts256(const std::int64_t *a, const std::int64_t *b, std::size_t &i,
+                                           const std::size_t n) noexcept {
+            __m256i acc = _mm256_setzero_si256();
+            for (; i + 4 <= n; i += 4) {
+                acc = _mm256_add_epi64(acc, mullo64(load256(a + i), load256(b + i)));
+            }
+            return horizontalSum64(acc);
+        }
+
+        inline std::int32_t sumProducts256(const std::int32_t *a, const std::int32_t *b, std::size_t &i,
+                                           const std::size_t n) noexcept {
+            __m256i acc = _mm256_setzero_si256();
+            for (; i + 8 <= n; i += 8) {
+                acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(load256(a + i), load256(b + i)));
+            }
+            return horizontalSum32(acc);
+        }
+#endif
+    } // namespace detail
+
+    template<SimdInteger T>
+    T sumAbsDiff(std::span<const T> a, std::span<const T> b) noexcept {
+        const std::size_t n = std::min(a.size(), b.size());
+        std::size_t i = 0;
+        T total{0};
+#if defined(__AVX512F__)
+        total += detail::sumAbsDiff512(a.data(), b.data(), i, n);
+#elif defined(__AVX2__)
+        total += detail::sumAbsDiff256(a.data(), b.data(), i, n);
+#endif
+        // Tail (or everything without SIMD support)
+        return total + detail::scalarReduce<T>(a.subspan(i, n - i), b.subspan(i, n - i), AbsoluteDifference{});
+    }
+
+    template<SimdInteger T>
+    T sumProducts(std::span<const T> a, std::span<const T> b) noexcept {
+        const std::size_t n = std::min(a.size(), b.size());
+        std::size_t i = 0;
+        T total{0};
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+        total += detail::sumProducts512(a.data(), b.data(), i, n);
+#elif defined(__AVX512F__)
+        if constexpr (std::same_as<T, std::int32_t>) {
+            total += detail::sumProducts512(a.data(), b.data(), i, n);
+        } else {
+            total += detail::sumProducts256(a.data(), b.data(), i, n);
+        }
+#elif defined(__AVX2__)
+        total += detail::sumProducts256(a.data(), b.data(), i, n);
+#endif
+        return total + detail::scalarReduce<T>(a.subspan(i, n - i), b.subspan(i, n - i), Product{});
+    }
+
+    template<SimdInteger T>
+    T parallelSumAbsDiff(std::span<const T> a, std::span<const T> b) {
+        const std::size_t n = std::min(a.size(), b.size());
+        return detail::chunkedReduce<T>(a.first(n), b.first(n), sumAbsDiff<T>);
+    }
+
+    template<SimdInteger T>
+    T parallelSumProducts(std::span<const T> a, std::span<const T> b) {
+        const std::size_t n = std::min(a.size(), b.size());
+        return detail::chunkedReduce<T>(a.first(n), b.first(n), sumProducts<T>);
+    }
+} // namespace aoc::simd
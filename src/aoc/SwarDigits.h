@@ -0,0 +1,55 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace aoc::swar {
+    // Up to eight ASCII digits decoded with a handful of 64-bit multiplies instead of a loop per character.
+    // Only little endian targets put the first character in the lowest byte, callers check SUPPORTED.
+    constexpr bool SUPPORTED = std::endian::native == std::endian::little;
+
+    constexpr size_t MAX_DIGITS = 8;
+
+    namespace detail {
+        constexpr std::uint64_t ZEROS = 0x3030303030303030ULL;
+
+        // Replaces the (8 - digits) lowest bytes with '0' so shorter numbers decode the same way
+        constexpr std::uint64_t padLeft(const std::uint64_t chunk, const size_t digits) noexcept {
+            if (digits >= MAX_DIGITS) return chunk;
+            const std::uint64_t low = (std::uint64_t{1} << (8 * (MAX_DIGITS - digits))) - 1;
+            return (chunk & ~low) | (ZEROS & low);
+        }
+    } // namespace detail
+
+    // True if every byte of the chunk is '0'..'9'
+    constexpr bool allDigits(const std::uint64_t chunk) noexcept {
+        return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+                (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+    }
+
+    // Decodes eight digits, first character in the lowest byte
+    constexpr std::uint32_t parseEight(std::uint64_t chunk) noexcept {
+        chunk -= detail::ZEROS;
+        chunk = ((chunk * (1 + (std::uint64_t{10} << 8))) >> 8) & 0x00FF00FF00FF00FFULL;
+        chunk = ((chunk * (1 + (std::uint64_t{100} << 16))) >> 16) & 0x0000FFFF0000FFFFULL;
+        return static_cast<std::uint32_t>((chunk * (1 + (std::uint64_t{10000} << 32))) >> 32);
+    }
+
+    // Parses text[offset, offset + digits) with 1 <= digits <= 8, false if any byte is not a digit.
+    // Reads the eight bytes ending at the last digit when they lie inside text, so no copy is needed.
+    inline bool parseDigits(const std::string_view text, const size_t offset, const size_t digits,
+                            std::uint32_t &value) noexcept {
+        std::uint64_t chunk = detail::ZEROS;
+        if (offset + digits >= MAX_DIGITS) {
+            std::memcpy(&chunk, text.data() + offset + digits - MAX_DIGITS, MAX_DIGITS);
+        } else {
+            std::memcpy(reinterpret_cast<char *>(&chunk) + (MAX_DIGITS - digits), text.data() + offset, digits);
+        }
+        chunk = detail::padLeft(chunk, digits);
+        if (!allDigits(chunk)) return false;
+        value = parseEight(chunk);
+        return true;
+    }
+} // namespace aoc::swar
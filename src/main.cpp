@@ -8,13 +8,21 @@ int main() {
     std::println("Day 1:");
     Day01::partOne();
     Day01::partTwo();
+    Day01::bothParts();
+    Day01::bothPartsExternal();
+    Day01::partTwoApproximate();
     std::println("Day 2:");
     Day02::partOne();
     Day02::partTwoBruteForce();
     Day02::partTwoSmart();
+    Day02::partTwoLinear();
+    Day02::partTwoWithTolerance(1);
+    Day02::bothPartsStreaming();
     std::println("Day 3:");
     Day03::partOne();
     Day03::partTwo();
+    Day03::bothPartsParallel();
+    Day03::allQueriesFromTokens();
     std::println("Day 4:");
     Day04::partOne();
     Day04::partTwo();
@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AhoCorasick.h"
+
+class AhoCorasickTest : public ::testing::Test {
+protected:
+    using Occurrence = std::pair<size_t, size_t>; // (word id, end offset)
+
+    static std::vector<Occurrence> scanAll(const aoc::AhoCorasick &automaton, const std::string_view text) {
+        std::vector<Occurrence> found;
+        automaton.scan(text, [&](const size_t id, const size_t end) { found.emplace_back(id, end); });
+        std::ranges::sort(found);
+        return found;
+    }
+
+    static std::vector<Occurrence> scanNaive(const std::span<const std::string_view> words,
+                                             const std::string_view text) {
+        std::vector<Occurrence> found;
+        for (size_t id = 0; id < words.size(); ++id) {
+            for (auto pos = text.find(words[id]); pos != std::string_view::npos; pos = text.find(words[id], pos + 1)) {
+                found.emplace_back(id, pos + words[id].size());
+            }
+        }
+        std::ranges::sort(found);
+        return found;
+    }
+
+    static void TestOverlappingWords() {
+        constexpr auto words = std::to_array<std::string_view>({"he", "she", "his", "hers", "he"});
+        const auto automaton = aoc::AhoCorasick::build(words);
+        ASSERT_TRUE(automaton.has_value());
+        EXPECT_EQ(automaton->wordCount(), 5);
+        EXPECT_EQ(automaton->wordLength(3), 4);
+
+        // "she" ends on "he" through the dictionary links; the duplicate "he" reports separately
+        const std::vector<Occurrence> expected{{0, 4}, {1, 4}, {3, 6}, {4, 4}};
+        EXPECT_EQ(scanAll(*automaton, "ushers"), expected);
+        EXPECT_TRUE(scanAll(*automaton, "").empty());
+        EXPECT_TRUE(scanAll(*automaton, "xyz\xff").empty());
+    }
+
+    static void TestMatchesNaiveSearch() {
+        std::mt19937_64 rng{7};
+        std::uniform_int_distribution<int> letter{'a', 'c'};
+        std::uniform_int_distribution<size_t> length{1, 5};
+        std::vector<std::string> storage(200);
+        for (auto &word: storage) {
+            word.resize(length(rng));
+            std::ranges::generate(word, [&] { return static_cast<char>(letter(rng)); });
+        }
+        const std::vector<std::string_view> words(storage.begin(), storage.end());
+        std::string text(5000, 'a');
+        std::ranges::generate(text, [&] { return static_cast<char>(letter(rng)); });
+
+        const auto automaton = aoc::AhoCorasick::build(words);
+        ASSERT_TRUE(automaton.has_value());
+        EXPECT_EQ(scanAll(*automaton, text), scanNaive(words, text));
+    }
+
+    static void TestInvalidDictionary() {
+        constexpr auto words = std::to_array<std::string_view>({"ok", ""});
+        EXPECT_FALSE(aoc::AhoCorasick::build(words).has_value());
+
+        // No words at all is fine, it just never matches
+        const auto empty = aoc::AhoCorasick::build({});
+        ASSERT_TRUE(empty.has_value());
+        EXPECT_EQ(empty->stateCount(), 1);
+        EXPECT_TRUE(scanAll(*empty, "anything").empty());
+    }
+};
+
+TEST_F(AhoCorasickTest, OverlappingWords) {
+    TestOverlappingWords();
+}
+
+TEST_F(AhoCorasickTest, MatchesNaiveSearch) {
+    TestMatchesNaiveSearch();
+}
+
+TEST_F(AhoCorasickTest, InvalidDictionary) {
+    TestInvalidDictionary();
+}
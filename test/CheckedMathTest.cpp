@@ -0,0 +1,78 @@
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "CheckedMath.h"
+
+class CheckedMathTest : public ::testing::Test {
+protected:
+    // Every pair of 8-bit operands against the exact result in int
+    template<typename T>
+    static void checkAllPairs() {
+        constexpr int lowest = std::numeric_limits<T>::min();
+        constexpr int highest = std::numeric_limits<T>::max();
+        const auto expect = [](const std::optional<T> actual, const int exact) {
+            if (exact < lowest || exact > highest) {
+                EXPECT_FALSE(actual.has_value()) << exact;
+            } else {
+                ASSERT_TRUE(actual.has_value()) << exact;
+                EXPECT_EQ(*actual, exact);
+            }
+        };
+        for (int a = lowest; a <= highest; ++a) {
+            for (int b = lowest; b <= highest; ++b) {
+                const auto x = static_cast<T>(a);
+                const auto y = static_cast<T>(b);
+                expect(aoc::checked::add(x, y), a + b);
+                expect(aoc::checked::sub(x, y), a - b);
+                expect(aoc::checked::mul(x, y), a * b);
+            }
+        }
+    }
+
+    static void TestExhaustiveNarrow() {
+        checkAllPairs<std::int8_t>();
+        checkAllPairs<std::uint8_t>();
+    }
+
+    static void TestWideBounds() {
+        constexpr auto lowest = std::numeric_limits<std::int64_t>::min();
+        constexpr auto highest = std::numeric_limits<std::int64_t>::max();
+        static_assert(aoc::checked::add(highest, std::int64_t{0}) == highest);
+        static_assert(!aoc::checked::add(highest, std::int64_t{1}));
+        static_assert(!aoc::checked::sub(lowest, std::int64_t{1}));
+        static_assert(!aoc::checked::sub(std::int64_t{0}, lowest));
+        static_assert(!aoc::checked::mul(lowest, std::int64_t{-1}));
+        static_assert(!aoc::checked::mul(std::int64_t{-1}, lowest));
+        static_assert(aoc::checked::mul(std::int64_t{1} << 31, std::int64_t{1} << 31) == std::int64_t{1} << 62);
+        static_assert(!aoc::checked::mul(std::int64_t{1} << 32, std::int64_t{1} << 31));
+        static_assert(!aoc::checked::sub(std::uint64_t{1}, std::uint64_t{2}));
+        static_assert(!aoc::checked::mul(~std::uint64_t{0}, std::uint64_t{2}));
+
+        // Random 32-bit operands against the exact 64-bit result
+        std::mt19937_64 rng{3};
+        std::uniform_int_distribution<std::int32_t> dist{std::numeric_limits<std::int32_t>::min(),
+                                                         std::numeric_limits<std::int32_t>::max()};
+        for (int i = 0; i < 100'000; ++i) {
+            const std::int32_t a = dist(rng);
+            const std::int32_t b = i % 4 == 0 ? dist(rng) % 70'000 : dist(rng);
+            const std::int64_t product = std::int64_t{a} * b;
+            const auto checked = aoc::checked::mul(a, b);
+            EXPECT_EQ(checked.has_value(), product == static_cast<std::int32_t>(product)) << a << " * " << b;
+            if (checked) {
+                EXPECT_EQ(*checked, product);
+            }
+        }
+    }
+};
+
+TEST_F(CheckedMathTest, ExhaustiveNarrow) {
+    TestExhaustiveNarrow();
+}
+
+TEST_F(CheckedMathTest, WideBounds) {
+    TestWideBounds();
+}
@@ -1,3 +1,6 @@
+#include <random>
+#include <unordered_map>
+
 #include <gtest/gtest.h>
 
 #include "Day01.h"
@@ -27,6 +30,37 @@ protected:
         ASSERT_FALSE(result.has_value());
     }
 
+    static void TestReadListsFixedWidth() {
+        // Fixed width records, then a line with another layout and a last line without a newline
+        const auto path = createTempFile("38450   56790\n00012   99999\n7 8\n12345   6");
+        const auto result = Day01::readLists<int64_t>(path);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->left, (std::vector<int64_t>{38450, 12, 7, 12345}));
+        EXPECT_EQ(result->right, (std::vector<int64_t>{56790, 99999, 8, 6}));
+
+        const std::string_view text = "38450   56790\n00012   99999\n7 8\n";
+        std::vector<int64_t> left;
+        std::vector<int64_t> right;
+        EXPECT_EQ(Day01::parseFixedWidth<int64_t>(text, left, right), 28);
+        EXPECT_EQ(left.size(), 2);
+
+        const auto crlf = createTempFile("11   22\r\n33   44\r\n");
+        const auto crlfResult = Day01::readLists<int32_t>(crlf);
+        ASSERT_TRUE(crlfResult.has_value());
+        EXPECT_EQ(crlfResult->left, (std::vector<int32_t>{11, 33}));
+        EXPECT_EQ(crlfResult->right, (std::vector<int32_t>{22, 44}));
+
+        // Too many digits for the element type skips the fast path entirely
+        EXPECT_FALSE(Day01::detectLayout<int16_t>("38450   56790\n").has_value());
+        EXPECT_TRUE(Day01::detectLayout<int32_t>("38450   56790\n").has_value());
+    }
+
+    static void TestReadListsFixedWidthInvalid() {
+        // Errors after the fast path stops are still reported by the general parser
+        EXPECT_FALSE(Day01::readLists<int64_t>(createTempFile("38450   56790\n3845x   12345\n")).has_value());
+        EXPECT_FALSE(Day01::readLists<int64_t>(createTempFile("38450   56790\n38450\n")).has_value());
+    }
+
     static void TestCalculateWithLists() {
         std::vector<int64_t> left{1, 2, 3};
         std::vector<int64_t> right{4, 5, 6};
@@ -65,6 +99,305 @@ protected:
 
         EXPECT_EQ(score, 11); // 2*2 + 2*2 + 3*1 = 11
     }
+
+    static void TestSortedListsBothResults() {
+        std::vector<int64_t> left{3, 4, 2, 1, 3, 3};
+        std::vector<int64_t> right{4, 3, 5, 3, 9, 3};
+        Day01::sortList(left);
+        Day01::sortList(right);
+
+        const auto [distance, similarity] = Day01::calculateWithLists<int64_t>(std::span{left}, std::span{right});
+
+        EXPECT_EQ(distance, 11); // 2 + 1 + 0 + 1 + 2 + 5
+        EXPECT_EQ(similarity, 31); // 3*3 + 4*1 + 2*0 + 1*0 + 3*3 + 3*3
+    }
+
+    static void TestExternalSortMatchesInMemory() {
+        std::mt19937_64 rng{7};
+        std::uniform_int_distribution<int64_t> dist{10000, 10500}; // Narrow range so the similarity is non-zero
+        std::string content;
+        for (int i = 0; i < 5000; ++i) {
+            content += std::format("{}   {}\n", dist(rng), dist(rng));
+        }
+        const auto path = createTempFile(content);
+
+        auto lists = Day01::readLists<int64_t>(path);
+        ASSERT_TRUE(lists.has_value());
+        Day01::sortList(lists->left);
+        Day01::sortList(lists->right);
+        const auto expected = Day01::calculateWithLists<int64_t>(std::span{lists->left}, std::span{lists->right});
+
+        // A budget of a few hundred values forces dozens of runs and several merge levels
+        const Day01::ExternalSortConfig config{3 * sizeof(int64_t) * 100, std::filesystem::temp_directory_path()};
+        const auto external = Day01::calculateExternal<int64_t>(path, config);
+        ASSERT_TRUE(external.has_value());
+        EXPECT_EQ(external->distance, expected.distance);
+        EXPECT_EQ(external->similarity, expected.similarity);
+    }
+
+    static void TestMergePlanWithinBudget() {
+        for (const size_t budget: {size_t{2400}, size_t{1} << 16, size_t{1} << 20, Day01::DEFAULT_MEMORY_BUDGET}) {
+            const auto plan = Day01::mergePlan<int64_t>(budget);
+            ASSERT_TRUE(plan.has_value()) << budget;
+            EXPECT_GE(plan->maxFanIn, 2);
+            EXPECT_GE(plan->reduceBuffer, Day01::MERGE_BUFFER_FLOOR);
+            EXPECT_LE((plan->maxFanIn + 1) * plan->reduceBuffer * sizeof(int64_t), budget) << budget;
+            // Worst case of the final pass: three streams, each split across maxFanIn runs
+            const size_t finalBuffer = plan->streamElements / plan->maxFanIn;
+            EXPECT_GE(finalBuffer, Day01::MERGE_BUFFER_FLOOR);
+            EXPECT_LE(3 * plan->maxFanIn * finalBuffer * sizeof(int64_t), budget) << budget;
+            // Spill phase: both column buffers plus the radix sort scratch
+            EXPECT_LE(3 * plan->runCapacity * sizeof(int64_t), budget) << budget;
+        }
+        EXPECT_FALSE(Day01::mergePlan<int64_t>(3 * sizeof(int64_t) * 2 * Day01::MERGE_BUFFER_FLOOR - 1).has_value());
+    }
+
+    static void TestRunWriterReleasesBuffer() {
+        // The merge phases are each sized to the whole budget, so the spill buffers must be gone by then
+        auto directory = aoc::sort::TempDirectory::create(std::filesystem::temp_directory_path());
+        ASSERT_TRUE(directory.has_value());
+        aoc::sort::RunWriter<int64_t> writer(*directory, 1000);
+        EXPECT_GE(writer.bufferBytes(), 1000 * sizeof(int64_t));
+        for (int64_t value = 0; value < 2500; ++value) {
+            ASSERT_TRUE(writer.push(2500 - value).has_value());
+        }
+        const auto runs = writer.finish();
+        ASSERT_TRUE(runs.has_value());
+        EXPECT_EQ(runs->size(), 3);
+        EXPECT_EQ(writer.bufferBytes(), 0);
+    }
+
+    static void TestIncrementalMatchesRecompute() {
+        std::mt19937_64 rng{11};
+        std::uniform_int_distribution<int64_t> dist{0, 50}; // Small range keeps duplicates and zero crossings common
+        std::vector<int64_t> left(200);
+        std::vector<int64_t> right(200);
+        std::ranges::generate(left, [&] { return dist(rng); });
+        std::ranges::generate(right, [&] { return dist(rng); });
+
+        auto incremental = Day01::IncrementalLists<int64_t>::fromLists(Day01::NumberLists(left, right));
+        ASSERT_TRUE(incremental.has_value());
+
+        for (int step = 0; step < 2000; ++step) {
+            // Replace one value on a random side so both lists keep the same size
+            auto &list = step % 2 == 0 ? left : right;
+            const size_t index = rng() % list.size();
+            const int64_t replacement = dist(rng);
+            if (step % 2 == 0) {
+                ASSERT_TRUE(incremental->eraseLeft(list[index]).has_value());
+                ASSERT_TRUE(incremental->insertLeft(replacement).has_value());
+            } else {
+                ASSERT_TRUE(incremental->eraseRight(list[index]).has_value());
+                ASSERT_TRUE(incremental->insertRight(replacement).has_value());
+            }
+            list[index] = replacement;
+
+            auto sortedLeft = left;
+            auto sortedRight = right;
+            std::ranges::sort(sortedLeft);
+            std::ranges::sort(sortedRight);
+            const auto expected = Day01::calculateWithLists<int64_t>(std::span{sortedLeft}, std::span{sortedRight});
+            ASSERT_EQ(incremental->distance(), expected.distance) << "step " << step;
+            ASSERT_EQ(incremental->similarity(), expected.similarity) << "step " << step;
+            ASSERT_EQ(incremental->nthLeft(step % 200), sortedLeft[static_cast<size_t>(step % 200)]);
+        }
+    }
+
+    static void TestIncrementalShrinkAndGrow() {
+        // Emptying and refilling the lists merges blocks down to one and splits them up again
+        std::mt19937_64 rng{17};
+        std::uniform_int_distribution<int64_t> dist{0, 1'000'000};
+        std::vector<int64_t> left(3000);
+        std::vector<int64_t> right(3000);
+        std::ranges::generate(left, [&] { return dist(rng); });
+        std::ranges::generate(right, [&] { return dist(rng); });
+        auto incremental = Day01::IncrementalLists<int64_t>::fromLists(Day01::NumberLists(left, right));
+        ASSERT_TRUE(incremental.has_value());
+
+        const auto check = [&] {
+            auto sortedLeft = left;
+            auto sortedRight = right;
+            std::ranges::sort(sortedLeft);
+            std::ranges::sort(sortedRight);
+            const auto expected = Day01::calculateWithLists<int64_t>(std::span{sortedLeft}, std::span{sortedRight});
+            ASSERT_EQ(incremental->distance(), expected.distance) << left.size() << " values";
+            ASSERT_EQ(incremental->similarity(), expected.similarity) << left.size() << " values";
+        };
+        while (!left.empty()) {
+            ASSERT_TRUE(incremental->eraseLeft(left.back()).has_value());
+            ASSERT_TRUE(incremental->eraseRight(right.back()).has_value());
+            left.pop_back();
+            right.pop_back();
+            if (left.size() % 250 == 0) check();
+        }
+        for (int step = 1; step <= 3000; ++step) {
+            left.push_back(dist(rng));
+            right.push_back(dist(rng));
+            ASSERT_TRUE(incremental->insertLeft(left.back()).has_value());
+            ASSERT_TRUE(incremental->insertRight(right.back()).has_value());
+            if (step % 250 == 0) check();
+        }
+    }
+
+    static void TestIncrementalInvalidUpdates() {
+        auto incremental = Day01::IncrementalLists<int64_t>::create();
+        ASSERT_TRUE(incremental.has_value());
+        EXPECT_FALSE(incremental->eraseLeft(15).has_value());
+
+        ASSERT_TRUE(incremental->insertLeft(15).has_value());
+        ASSERT_TRUE(incremental->insertRight(12).has_value());
+        EXPECT_EQ(incremental->distance(), 3);
+        EXPECT_EQ(incremental->similarity(), 0);
+        EXPECT_EQ(incremental->leftSize(), 1);
+        EXPECT_FALSE(incremental->nthRight(1).has_value());
+        EXPECT_FALSE(incremental->eraseRight(15).has_value());
+    }
+
+    static void TestIncrementalAlternating() {
+        // Sparse values alternating left, right, left, ...: toggling a left value below all of them
+        // flips every later imbalance between 0 and 1, the worst case for the lazy updates
+        constexpr int64_t spacing = int64_t{1} << 30;
+        std::vector<int64_t> left;
+        std::vector<int64_t> right;
+        for (int64_t i = 1; i <= 500; ++i) {
+            left.push_back(2 * i * spacing);
+            right.push_back((2 * i + 1) * spacing);
+        }
+        auto incremental = Day01::IncrementalLists<int64_t>::fromLists(Day01::NumberLists(left, right));
+        ASSERT_TRUE(incremental.has_value());
+        ASSERT_EQ(incremental->distance(), 500 * spacing);
+
+        std::mt19937_64 rng{5};
+        for (int step = 0; step < 400; ++step) {
+            // Mix the toggles with random updates anywhere in the range so blocks split and merge
+            if (step % 4 == 3) {
+                const int64_t value = static_cast<int64_t>(rng() % static_cast<uint64_t>(1002 * spacing));
+                ASSERT_TRUE(incremental->insertRight(value).has_value());
+                ASSERT_TRUE(incremental->insertLeft(value + 1).has_value());
+                right.push_back(value);
+                left.push_back(value + 1);
+            } else if (step % 2 == 0) {
+                ASSERT_TRUE(incremental->insertLeft(0).has_value());
+                ASSERT_TRUE(incremental->insertRight(1).has_value());
+                left.push_back(0);
+                right.push_back(1);
+            } else {
+                ASSERT_TRUE(incremental->eraseLeft(0).has_value());
+                ASSERT_TRUE(incremental->eraseRight(1).has_value());
+                left.erase(std::ranges::find(left, 0));
+                right.erase(std::ranges::find(right, 1));
+            }
+
+            auto sortedLeft = left;
+            auto sortedRight = right;
+            std::ranges::sort(sortedLeft);
+            std::ranges::sort(sortedRight);
+            const auto expected = Day01::calculateWithLists<int64_t>(std::span{sortedLeft}, std::span{sortedRight});
+            ASSERT_EQ(incremental->distance(), expected.distance) << "step " << step;
+            ASSERT_EQ(incremental->similarity(), expected.similarity) << "step " << step;
+            ASSERT_EQ(incremental->nthRight(sortedRight.size() - 1), sortedRight.back());
+        }
+    }
+
+    static void TestExternalSortInvalid() {
+        const auto path = createTempFile("1 2\n3\n5 6");
+        const Day01::ExternalSortConfig config{1024, std::filesystem::temp_directory_path()};
+        EXPECT_FALSE(Day01::calculateExternal<int64_t>(path, config).has_value());
+    }
+
+    static void TestListCacheRoundTrip() {
+        const auto path = std::filesystem::temp_directory_path() / "test_cache.bin";
+        const Day01::NumberLists<int32_t> lists({5, -1, 3}, {2, 2, 9});
+        ASSERT_TRUE(Day01::writeListCache<int32_t>(path, lists, false).has_value());
+
+        const auto cached = Day01::readListCache<int32_t>(path);
+        ASSERT_TRUE(cached.has_value());
+        EXPECT_FALSE(cached->sorted);
+        EXPECT_EQ(cached->lists.left, lists.left);
+        EXPECT_EQ(cached->lists.right, lists.right);
+
+        // Same bytes read as another element type, or cut short, must be rejected
+        EXPECT_FALSE(Day01::readListCache<int64_t>(path).has_value());
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+        EXPECT_FALSE(Day01::readListCache<int32_t>(path).has_value());
+        std::filesystem::remove(path);
+    }
+
+    static void TestSortedListsFromCache() {
+        const auto path = createTempFile("3   4\n4   3\n2   5\n1   3\n3   9\n3   3\n");
+        const auto cachePath = Day01::cachePathFor(path);
+        std::filesystem::remove(cachePath);
+
+        const auto parsed = Day01::loadSortedLists<int64_t>(path);
+        ASSERT_TRUE(parsed.has_value());
+        ASSERT_TRUE(std::filesystem::exists(cachePath));
+        EXPECT_EQ(parsed->left, (std::vector<int64_t>{1, 2, 3, 3, 3, 4}));
+        EXPECT_EQ(parsed->right, (std::vector<int64_t>{3, 3, 3, 4, 5, 9}));
+
+        const auto cached = Day01::readListCache<int64_t>(cachePath);
+        ASSERT_TRUE(cached.has_value());
+        EXPECT_TRUE(cached->sorted);
+
+        // The second load comes from the cache and must agree with the parse
+        const auto reloaded = Day01::loadSortedLists<int64_t>(path);
+        ASSERT_TRUE(reloaded.has_value());
+        EXPECT_EQ(reloaded->left, parsed->left);
+        EXPECT_EQ(reloaded->right, parsed->right);
+        std::filesystem::remove(cachePath);
+    }
+
+    static void TestSketchEstimateBounds() {
+        std::mt19937_64 rng{13};
+        std::uniform_int_distribution<int64_t> dist{10000, 12000};
+        std::vector<int64_t> left(20000);
+        std::vector<int64_t> right(20000);
+        std::ranges::generate(left, [&] { return dist(rng); });
+        std::ranges::generate(right, [&] { return dist(rng); });
+
+        auto sortedLeft = left;
+        auto sortedRight = right;
+        std::ranges::sort(sortedLeft);
+        std::ranges::sort(sortedRight);
+        const auto exact = Day01::calculateWithLists<int64_t>(std::span{sortedLeft}, std::span{sortedRight});
+
+        // A narrow sketch collides a lot, a wide one should be close to exact
+        for (const size_t width: {64, 1024, 65536}) {
+            const auto estimate = Day01::estimateSimilarity<int64_t>(std::span<const int64_t>{left},
+                                                                     std::span<const int64_t>{right},
+                                                                     Day01::SketchConfig{width, 5});
+            ASSERT_TRUE(estimate.has_value());
+            EXPECT_GE(estimate->estimate, exact.similarity) << "width " << width;
+            EXPECT_LE(estimate->estimate - exact.similarity, estimate->errorBound) << "width " << width;
+            EXPECT_GT(estimate->confidence, 0.99);
+        }
+    }
+
+    static void TestSketchEstimateFromFile() {
+        const auto path = createTempFile("3   4\n4   3\n2   5\n1   3\n3   9\n3   3\n");
+        const auto estimate = Day01::estimateSimilarity<int64_t>(path, Day01::SketchConfig{1024, 4});
+        ASSERT_TRUE(estimate.has_value());
+        EXPECT_GE(estimate->estimate, 31);
+        EXPECT_LE(estimate->estimate - 31, estimate->errorBound);
+
+        EXPECT_FALSE(Day01::estimateSimilarity<int64_t>(createTempFile("1 2\n-3 4\n"),
+                                                        Day01::SketchConfig{1024, 4}).has_value());
+        EXPECT_FALSE(Day01::estimateSimilarity<int64_t>(createTempFile("1 2\n3\n"),
+                                                        Day01::SketchConfig{1024, 4}).has_value());
+    }
+
+    static void TestSketchInnerProductOverflow() {
+        aoc::CountMinSketch<int64_t> weights(16, 3);
+        aoc::CountMinSketch<int64_t> counts(16, 3);
+        weights.add(7, int64_t{1} << 31);
+        counts.add(7, int64_t{1} << 31);
+        const auto fits = weights.innerProduct(counts);
+        ASSERT_TRUE(fits.has_value());
+        EXPECT_EQ(*fits, int64_t{1} << 62);
+
+        // 2^63 is one past the counter in every row
+        counts.add(7, int64_t{1} << 31);
+        EXPECT_FALSE(weights.innerProduct(counts).has_value());
+    }
 };
 
 TEST_F(Day01Test, ReadListsValid) {
@@ -75,6 +408,14 @@ TEST_F(Day01Test, ReadListsInvalid) {
     TestReadListsInvalid();
 }
 
+TEST_F(Day01Test, ReadListsFixedWidth) {
+    TestReadListsFixedWidth();
+}
+
+TEST_F(Day01Test, ReadListsFixedWidthInvalid) {
+    TestReadListsFixedWidthInvalid();
+}
+
 TEST_F(Day01Test, CalculateWithLists) {
     TestCalculateWithLists();
 }
@@ -85,4 +426,60 @@ TEST_F(Day01Test, NumberListsConstruction) {
 
 TEST_F(Day01Test, SimilarityScore) {
     TestSimilarityScore();
-}
\ No newline at end of file
+}
+
+TEST_F(Day01Test, SortedListsBothResults) {
+    TestSortedListsBothResults();
+}
+
+TEST_F(Day01Test, ExternalSortMatchesInMemory) {
+    TestExternalSortMatchesInMemory();
+}
+
+TEST_F(Day01Test, MergePlanWithinBudget) {
+    TestMergePlanWithinBudget();
+}
+
+TEST_F(Day01Test, RunWriterReleasesBuffer) {
+    TestRunWriterReleasesBuffer();
+}
+
+TEST_F(Day01Test, ExternalSortInvalid) {
+    TestExternalSortInvalid();
+}
+
+TEST_F(Day01Test, IncrementalMatchesRecompute) {
+    TestIncrementalMatchesRecompute();
+}
+
+TEST_F(Day01Test, IncrementalShrinkAndGrow) {
+    TestIncrementalShrinkAndGrow();
+}
+
+TEST_F(Day01Test, IncrementalInvalidUpdates) {
+    TestIncrementalInvalidUpdates();
+}
+
+TEST_F(Day01Test, IncrementalAlternating) {
+    TestIncrementalAlternating();
+}
+
+TEST_F(Day01Test, ListCacheRoundTrip) {
+    TestListCacheRoundTrip();
+}
+
+TEST_F(Day01Test, SortedListsFromCache) {
+    TestSortedListsFromCache();
+}
+
+TEST_F(Day01Test, SketchEstimateBounds) {
+    TestSketchEstimateBounds();
+}
+
+TEST_F(Day01Test, SketchEstimateFromFile) {
+    TestSketchEstimateFromFile();
+}
+
+TEST_F(Day01Test, SketchInnerProductOverflow) {
+    TestSketchInnerProductOverflow();
+}
@@ -1,4 +1,7 @@
 #include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
 
 #include <gtest/gtest.h>
 
@@ -18,9 +21,10 @@ protected:
         const auto result = Day02::readLists<int64_t>(path);
         ASSERT_TRUE(result.has_value());
         EXPECT_EQ(result->size(), 3);
-        EXPECT_EQ((*result)[0], (std::vector<int64_t>{1, 2, 3}));
-        EXPECT_EQ((*result)[1], (std::vector<int64_t>{4, 5, 6}));
-        EXPECT_EQ((*result)[2], (std::vector<int64_t>{7, 8, 9}));
+        EXPECT_TRUE(std::ranges::equal((*result)[0], std::vector<int64_t>{1, 2, 3}));
+        EXPECT_TRUE(std::ranges::equal((*result)[1], std::vector<int64_t>{4, 5, 6}));
+        EXPECT_TRUE(std::ranges::equal((*result)[2], std::vector<int64_t>{7, 8, 9}));
+        EXPECT_EQ(result->values().size(), 9);
     }
 
     static void TestReadListsInvalid() {
@@ -91,8 +95,249 @@ protected:
         EXPECT_FALSE(Day02::canBeMadeSafe<int64_t>(std::span{impossible}));
     }
 
+    static void TestCanBeMadeSafeLinear() {
+        std::vector<int64_t> safe{7, 6, 4, 2, 1};
+        EXPECT_TRUE(Day02::canBeMadeSafeLinear<int64_t>(std::span{safe}));
+
+        // Removing the first or the last level is enough
+        std::vector<int64_t> badFirst{9, 1, 2, 3};
+        EXPECT_TRUE(Day02::canBeMadeSafeLinear<int64_t>(std::span{badFirst}));
+        std::vector<int64_t> badLast{1, 2, 3, 9};
+        EXPECT_TRUE(Day02::canBeMadeSafeLinear<int64_t>(std::span{badLast}));
+
+        // The first pair suggests the wrong direction
+        std::vector<int64_t> misleadingStart{5, 4, 6, 7, 8};
+        EXPECT_TRUE(Day02::canBeMadeSafeLinear<int64_t>(std::span{misleadingStart}));
+
+        std::vector<int64_t> impossible{1, 2, 7, 8, 9};
+        EXPECT_FALSE(Day02::canBeMadeSafeLinear<int64_t>(std::span{impossible}));
+        std::vector<int64_t> twoRemovals{1, 5, 2, 6, 3};
+        EXPECT_FALSE(Day02::canBeMadeSafeLinear<int64_t>(std::span{twoRemovals}));
+
+        std::vector<int64_t> empty;
+        EXPECT_TRUE(Day02::canBeMadeSafeLinear<int64_t>(std::span{empty}));
+    }
+
+    static void TestLinearMatchesBruteForce() {
+        // Short reports over a tiny range hit every mix of bad steps and direction changes
+        std::mt19937_64 rng{5};
+        std::uniform_int_distribution<int64_t> value{0, 9};
+        std::uniform_int_distribution<size_t> length{0, 9};
+        for (int i = 0; i < 20000; ++i) {
+            std::vector<int64_t> report(length(rng));
+            std::ranges::generate(report, [&] { return value(rng); });
+            const std::span<const int64_t> view{report};
+            ASSERT_EQ(Day02::canBeMadeSafeLinear<int64_t>(view), Day02::isSafeWithChance<int64_t>(view))
+                << testing::PrintToString(report);
+            ASSERT_EQ(Day02::canBeMadeSafeLinear<int64_t>(view), Day02::canBeMadeSafe<int64_t>(view))
+                << testing::PrintToString(report);
+        }
+    }
+
+    static void TestCanBeMadeSafeUpTo() {
+        std::vector<int64_t> twoBad{1, 9, 2, 9, 3, 4};
+        EXPECT_FALSE(Day02::canBeMadeSafeUpTo<int64_t>(std::span{twoBad}, 1));
+        EXPECT_TRUE(Day02::canBeMadeSafeUpTo<int64_t>(std::span{twoBad}, 2));
+        EXPECT_FALSE((Day02::canBeMadeSafeUpTo<int64_t, 1>(std::span{twoBad})));
+        EXPECT_TRUE((Day02::canBeMadeSafeUpTo<int64_t, 2>(std::span{twoBad})));
+
+        // A run of bad levels at either end
+        std::vector<int64_t> badPrefix{20, 30, 40, 1, 2, 3};
+        EXPECT_FALSE(Day02::canBeMadeSafeUpTo<int64_t>(std::span{badPrefix}, 2));
+        EXPECT_TRUE(Day02::canBeMadeSafeUpTo<int64_t>(std::span{badPrefix}, 3));
+        std::vector<int64_t> badSuffix{5, 4, 3, 9, 9};
+        EXPECT_TRUE((Day02::canBeMadeSafeUpTo<int64_t, 2>(std::span{badSuffix})));
+
+        std::vector<int64_t> flat{7, 7, 7};
+        EXPECT_FALSE(Day02::canBeMadeSafeUpTo<int64_t>(std::span{flat}, 1));
+        EXPECT_TRUE(Day02::canBeMadeSafeUpTo<int64_t>(std::span{flat}, 2));
+        EXPECT_TRUE(Day02::canBeMadeSafeUpTo<int64_t>(std::span{flat}, 100));
+    }
+
+    static void TestUpToMatchesBruteForce() {
+        std::mt19937_64 rng{17};
+        std::uniform_int_distribution<int64_t> value{0, 12};
+        std::uniform_int_distribution<size_t> length{0, 9};
+        for (int i = 0; i < 3000; ++i) {
+            std::vector<int64_t> report(length(rng));
+            std::ranges::generate(report, [&] { return value(rng); });
+            const std::span<const int64_t> view{report};
+            for (size_t k = 0; k <= 3; ++k) {
+                ASSERT_EQ(Day02::canBeMadeSafeUpTo<int64_t>(view, k), Day02::isSafeWithChances<int64_t>(view, k))
+                    << "k " << k << " " << testing::PrintToString(report);
+            }
+            ASSERT_EQ((Day02::canBeMadeSafeUpTo<int64_t, 1>(view)), Day02::canBeMadeSafeLinear<int64_t>(view));
+            ASSERT_EQ((Day02::canBeMadeSafeUpTo<int64_t, 0>(view)), Day02::isSafe<int64_t>(view));
+        }
+    }
+
+    static void TestScanReportsMatchesParsed() {
+        std::mt19937_64 rng{23};
+        std::uniform_int_distribution<int64_t> step{-4, 4};
+        std::uniform_int_distribution<size_t> length{0, 10};
+        std::string content;
+        for (int report = 0; report < 2000; ++report) {
+            int64_t value = 40;
+            const size_t levels = length(rng);
+            for (size_t level = levels; level > 0; --level) {
+                value += step(rng);
+                content += std::format("{}{}", value, level > 1 ? "  " : "");
+            }
+            content += report % 7 == 0 && levels > 0 ? "\r\n" : "\n";
+        }
+        content += "1 2 3"; // No line end after the last report
+
+        const auto lists = Day02::readLists<int64_t>(createTempFile(content));
+        ASSERT_TRUE(lists.has_value());
+        const size_t safe = Day02::countSafeParallel(*lists, Day02::isSafe<int64_t>);
+        const size_t tolerated = Day02::countSafeParallel(*lists, Day02::canBeMadeSafe<int64_t>);
+
+        std::istringstream stream(content);
+        const auto counts = Day02::scanReports<int64_t>(stream);
+        ASSERT_TRUE(counts.has_value());
+        EXPECT_EQ(counts->safe, safe);
+        EXPECT_EQ(counts->safeWithOneRemoval, tolerated);
+
+        // Splitting the input at every byte must not change anything
+        Day02::ReportScanner<int64_t> scanner;
+        for (const char c: content) {
+            ASSERT_TRUE(scanner.feed(std::string_view{&c, 1}).has_value());
+        }
+        const auto byteWise = scanner.finish();
+        ASSERT_TRUE(byteWise.has_value());
+        EXPECT_EQ(byteWise->safe, safe);
+        EXPECT_EQ(byteWise->safeWithOneRemoval, tolerated);
+    }
+
+    static void TestScanReportsInvalid() {
+        for (const std::string content: {"1 2 3\nabc\n7 8 9", "1 2 - 3\n", "4 5-6\n", "99999999999999999999 1\n"}) {
+            std::istringstream stream(content);
+            EXPECT_FALSE(Day02::scanReports<int64_t>(stream).has_value()) << content;
+        }
+        std::istringstream negative("-3 -2 -1\n\n");
+        const auto counts = Day02::scanReports<int64_t>(negative);
+        ASSERT_TRUE(counts.has_value());
+        EXPECT_EQ(counts->safe, 1);
+    }
+
+    static void TestBatchedMatchesScalar() {
+        // Report counts around the batch width, lengths from empty to longer than the puzzle's
+        std::mt19937_64 rng{9};
+        std::uniform_int_distribution<int64_t> step{-5, 5};
+        std::uniform_int_distribution<size_t> length{0, 12};
+        for (const size_t reports: {0, 1, 31, 32, 33, 100, 1000}) {
+            aoc::FlatLists<int64_t> lists;
+            for (size_t report = 0; report < reports; ++report) {
+                int64_t value = 0;
+                for (size_t level = length(rng); level > 0; --level) {
+                    value += step(rng);
+                    lists.push(value);
+                }
+                lists.endRow();
+            }
+            EXPECT_EQ(Day02::countSafeParallel(lists, Day02::BatchedSafe<>{}),
+                      Day02::countSafeParallel(lists, Day02::isSafe<int64_t>)) << reports << " reports";
+        }
+
+        // Diffs far outside int8 must still be rejected, not wrap into valid steps
+        const aoc::FlatLists<int64_t> extremes{{0, 256 + 1}, {0, -(int64_t{1} << 40) + 2}, {1, 2, 3}};
+        EXPECT_EQ(Day02::safetyMask(extremes, 0), 0b100u);
+
+        // Diffs that overflow the level type saturate, and unsigned levels are never subtracted unsigned
+        constexpr int64_t largest = std::numeric_limits<int64_t>::max();
+        const aoc::FlatLists<int64_t> overflowing{{-largest, largest}, {largest, -largest}, {largest - 2, largest}};
+        EXPECT_EQ(Day02::safetyMask(overflowing, 0), 0b100u);
+        const aoc::FlatLists<uint32_t> unsignedLevels{{5, 3, 1}, {0, 4'000'000'000u}, {4'000'000'000u, 3}, {7, 8, 10}};
+        EXPECT_EQ(Day02::safetyMask(unsignedLevels, 0), 0b1001u);
+        const aoc::FlatLists<uint64_t> unsignedWide{{1, 0}, {0, ~uint64_t{0}}, {~uint64_t{0}, 1}};
+        EXPECT_EQ(Day02::safetyMask(unsignedWide, 0), 0b1u);
+        const aoc::FlatLists<int32_t> narrow{{std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max()},
+                                             {-3, -1, 2}};
+        EXPECT_EQ(Day02::safetyMask(narrow, 0), 0b10u);
+    }
+
+    static void TestSafetyPolicies() {
+        using Gentle = Day02::SafetyPolicy<0, 2>;
+        using Rising = Day02::SafetyPolicy<1, 3, Day02::Monotonicity::Increasing>;
+        using Steep = Day02::SafetyPolicy<2, 5, Day02::Monotonicity::Decreasing>;
+
+        std::vector<int64_t> plateau{1, 1, 3, 3, 4};
+        EXPECT_TRUE((Day02::isSafe<int64_t, Gentle>(plateau)));
+        EXPECT_FALSE(Day02::isSafe<int64_t>(plateau));
+        std::vector<int64_t> falling{9, 7, 4};
+        EXPECT_TRUE(Day02::isSafe<int64_t>(falling));
+        EXPECT_FALSE((Day02::isSafe<int64_t, Rising>(falling)));
+        EXPECT_TRUE((Day02::isSafe<int64_t, Steep>(falling)));
+        std::vector<int64_t> onceWrong{1, 2, 9, 3};
+        EXPECT_TRUE((Day02::canBeMadeSafe<int64_t, Rising>(onceWrong)));
+        EXPECT_FALSE((Day02::canBeMadeSafe<int64_t, Steep>(onceWrong)));
+
+        std::mt19937_64 rng{31};
+        std::uniform_int_distribution<int64_t> step{-6, 6};
+        std::uniform_int_distribution<size_t> length{0, 9};
+        aoc::FlatLists<int64_t> lists;
+        std::string content;
+        for (int report = 0; report < 1500; ++report) {
+            int64_t value = 50;
+            for (size_t level = length(rng); level > 0; --level) {
+                value += step(rng);
+                lists.push(value);
+                content += std::format("{} ", value);
+            }
+            lists.endRow();
+            content += "\n";
+        }
+        checkPolicy<Gentle>(lists, content);
+        checkPolicy<Rising>(lists, content);
+        checkPolicy<Steep>(lists, content);
+        checkPolicy<Day02::PuzzleRules>(lists, content);
+    }
+
+    // Every check instantiated with the policy has to agree with the brute force one
+    template<typename Policy>
+    static void checkPolicy(const aoc::FlatLists<int64_t> &lists, const std::string &content) {
+        size_t safe = 0;
+        size_t tolerated = 0;
+        for (const auto report: lists) {
+            const bool reference = Day02::isSafeWithChance<int64_t, Policy>(report);
+            ASSERT_EQ((Day02::canBeMadeSafe<int64_t, Policy>(report)), reference) << testing::PrintToString(report);
+            ASSERT_EQ((Day02::canBeMadeSafeLinear<int64_t, Policy>(report)), reference);
+            ASSERT_EQ((Day02::canBeMadeSafeUpTo<int64_t, 1, Policy>(report)), reference);
+            ASSERT_EQ((Day02::canBeMadeSafeUpTo<int64_t, 2, Policy>(report)),
+                      (Day02::isSafeWithChances<int64_t, Policy>(report, 2)));
+            if (report.empty()) continue; // Blank lines are not reports when streaming
+            safe += Day02::isSafe<int64_t, Policy>(report) ? 1 : 0;
+            tolerated += reference ? 1 : 0;
+        }
+        EXPECT_EQ(Day02::countSafeParallel(lists, Day02::BatchedSafe<Policy>{}),
+                  Day02::countSafeParallel(lists, Day02::isSafe<int64_t, Policy>));
+
+        std::istringstream stream(content);
+        const auto counts = Day02::scanReports<int64_t, Policy>(stream);
+        ASSERT_TRUE(counts.has_value());
+        EXPECT_EQ(counts->safe, safe);
+        EXPECT_EQ(counts->safeWithOneRemoval, tolerated);
+    }
+
+    static void TestFlatLists() {
+        aoc::FlatLists<int64_t> lists{{1, 2}, {}, {3, 4, 5}};
+        lists.push(6);
+        lists.endRow();
+        ASSERT_EQ(lists.size(), 4);
+        EXPECT_TRUE(lists[1].empty());
+        EXPECT_TRUE(std::ranges::equal(lists[2], std::vector<int64_t>{3, 4, 5}));
+        EXPECT_TRUE(std::ranges::equal(lists.offsets(), std::vector<size_t>{0, 2, 2, 5, 6}));
+
+        size_t rows = 0;
+        for (const auto row: lists) {
+            EXPECT_TRUE(std::ranges::equal(row, lists[rows++]));
+        }
+        EXPECT_EQ(rows, lists.size());
+        static_assert(std::random_access_iterator<aoc::FlatLists<int64_t>::Iterator>);
+    }
+
     static void TestCountSafeParallel() {
-        const std::vector<std::vector<int64_t>> testData{
+        const aoc::FlatLists<int64_t> testData{
             {1, 2, 3},    // safe
             {3, 2, 1},    // safe
             {1, 5, 2},    // unsafe but can be made safe
@@ -110,6 +355,8 @@ protected:
             Day02::canBeMadeSafe<int64_t>
         );
         EXPECT_EQ(canBeMadeSafeCount, 3);
+
+        EXPECT_EQ(Day02::countSafeParallel(testData, Day02::canBeMadeSafeLinear<int64_t>), 3);
     }
 };
 
@@ -133,6 +380,42 @@ TEST_F(Day02Test, CanBeMadeSafe) {
     TestCanBeMadeSafe();
 }
 
+TEST_F(Day02Test, CanBeMadeSafeLinear) {
+    TestCanBeMadeSafeLinear();
+}
+
+TEST_F(Day02Test, LinearMatchesBruteForce) {
+    TestLinearMatchesBruteForce();
+}
+
+TEST_F(Day02Test, CanBeMadeSafeUpTo) {
+    TestCanBeMadeSafeUpTo();
+}
+
+TEST_F(Day02Test, UpToMatchesBruteForce) {
+    TestUpToMatchesBruteForce();
+}
+
+TEST_F(Day02Test, ScanReportsMatchesParsed) {
+    TestScanReportsMatchesParsed();
+}
+
+TEST_F(Day02Test, ScanReportsInvalid) {
+    TestScanReportsInvalid();
+}
+
+TEST_F(Day02Test, BatchedMatchesScalar) {
+    TestBatchedMatchesScalar();
+}
+
+TEST_F(Day02Test, SafetyPolicies) {
+    TestSafetyPolicies();
+}
+
+TEST_F(Day02Test, FlatLists) {
+    TestFlatLists();
+}
+
 TEST_F(Day02Test, CountSafeParallel) {
     TestCountSafeParallel();
 }
\ No newline at end of file
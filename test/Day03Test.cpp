@@ -1,3 +1,6 @@
+#include <random>
+#include <sstream>
+
 #include <gtest/gtest.h>
 
 #include "Day03.h"
@@ -75,6 +78,179 @@ protected:
         EXPECT_EQ(result, 998001);
     }
 
+    static void TestScannerEdgeCases() {
+        EXPECT_EQ(Day03::processMultiplications<int64_t>("mul(1234,5)mul(12,34mul( 1,2)mul(1,2 )mul(,3)"), 0);
+        EXPECT_EQ(Day03::processMultiplications<int64_t>("mmul(2,3)mul(mul(4,5)mul(6,7"), 26);
+        EXPECT_EQ(Day03::sumMultiplicationsDD<int64_t>("mul(1,2)don't()mul(3,4)do_()mul(5,6)do()mul(7,8)"), 58);
+        EXPECT_EQ(Day03::sumMultiplicationsDD<int64_t>("don'tmul(2,2)don't(mul(3,3)do(mul(4,4)"), 29);
+
+        std::vector<std::pair<Day03::Opcode, size_t> > seen;
+        Day03::forEachInstruction("xdo()mul(1,2)?don't()", [&seen](const Day03::Instruction &instruction,
+                                                                 const size_t offset) {
+            seen.emplace_back(instruction.opcode, offset);
+        });
+        const std::vector<std::pair<Day03::Opcode, size_t> > expected{
+            {Day03::Opcode::Do, 1}, {Day03::Opcode::Mul, 5}, {Day03::Opcode::Dont, 14}
+        };
+        EXPECT_EQ(seen, expected);
+    }
+
+    static void TestScannerMatchesRegex() {
+        // Valid instructions mixed with near misses and noise
+        const std::vector<std::string> fragments{
+            "mul(", "mul(7,", "mul(12,345)", "mul(1,2)", "mul(999,0)", "mul(1234,1)", ",", ")", "do()", "don't()",
+            "do(", "don't", "d", "m", "u", "l", "(", "3", "42", " ", "x", "\n", "mul[1,2]"
+        };
+        std::mt19937_64 rng{3};
+        std::uniform_int_distribution<size_t> pick{0, fragments.size() - 1};
+        for (int round = 0; round < 300; ++round) {
+            std::string memory;
+            for (int i = 0; i < 60; ++i) {
+                memory += fragments[pick(rng)];
+            }
+            ASSERT_EQ(Day03::processMultiplications<int64_t>(memory),
+                      Day03::processMultiplicationsRegex<int64_t>(memory)) << memory;
+            ASSERT_EQ(Day03::sumMultiplicationsDD<int64_t>(memory),
+                      Day03::sumMultiplicationsDDRegex<int64_t>(memory)) << memory;
+        }
+    }
+
+    static void TestCandidateMask() {
+        std::mt19937_64 rng{5};
+        std::uniform_int_distribution<size_t> letter{0, 4};
+        for (const size_t size: {0, 1, 63, 64, 65, 129, 300}) {
+            std::string text(size, ' ');
+            std::ranges::generate(text, [&] { return "mudo."[letter(rng)]; });
+            for (size_t first = 0; first < size; first += Day03::PREFILTER_BLOCK) {
+                uint64_t expected = 0;
+                for (size_t i = 0; i < Day03::PREFILTER_BLOCK && first + i + 1 < size; ++i) {
+                    const std::string_view pair = std::string_view{text}.substr(first + i, 2);
+                    expected |= static_cast<uint64_t>(pair == "mu" || pair == "do") << i;
+                }
+                ASSERT_EQ(Day03::candidateMask(text, first), expected) << size << " " << first;
+            }
+        }
+
+        // An instruction starting at the end of one block and finishing in the next
+        std::string straddling(62, '.');
+        straddling += "mul(3,4)do()";
+        EXPECT_EQ(Day03::processMultiplications<int64_t>(straddling), 12);
+    }
+
+    static void TestScanParallel() {
+        const std::vector<std::string> fragments{
+            "mul(", "mul(123,456)", "mul(1,2)", "mul(99,", "do()", "don't()", "d", "o", ")", "x", "7"
+        };
+        std::mt19937_64 rng{11};
+        std::uniform_int_distribution<size_t> pick{0, fragments.size() - 1};
+        for (int round = 0; round < 50; ++round) {
+            std::string memory;
+            for (int i = 0; i < 400; ++i) {
+                memory += fragments[pick(rng)];
+            }
+            const auto all = Day03::processMultiplications<int64_t>(memory);
+            const auto enabled = Day03::sumMultiplicationsDD<int64_t>(memory);
+            // Tiny chunks cut through nearly every instruction
+            for (const size_t chunk: {1, 3, 7, 12, 64, 1000, 1 << 20}) {
+                const auto summary = Day03::scanParallel<int64_t>(memory, chunk);
+                ASSERT_EQ(summary.all, all) << chunk;
+                ASSERT_EQ(summary.whenEnabled, enabled) << chunk;
+            }
+        }
+        EXPECT_EQ(Day03::scanParallel<int64_t>("").whenEnabled, 0);
+    }
+
+    static void TestCombineChunks() {
+        using Summary = Day03::ChunkSummary<int64_t>;
+        const Summary disables{5, 5, 0, Day03::Toggle::Disable}; // "mul(1,5)don't()"
+        const Summary plain{7, 7, 0, Day03::Toggle::Keep}; // "mul(1,7)"
+        const Summary enables{3, 3, 0, Day03::Toggle::Enable}; // "mul(1,3)do()"
+        EXPECT_EQ(Day03::combine(disables, plain).whenEnabled, 5);
+        EXPECT_EQ(Day03::combine(enables, plain).whenDisabled, 7);
+        EXPECT_EQ(Day03::combine(plain, disables).exit, Day03::Toggle::Disable);
+        EXPECT_EQ(Day03::combine(enables, plain).exit, Day03::Toggle::Enable);
+        const auto grouped = Day03::combine(Day03::combine(disables, plain), enables);
+        const auto regrouped = Day03::combine(disables, Day03::combine(plain, enables));
+        EXPECT_EQ(grouped.all, regrouped.all);
+        EXPECT_EQ(grouped.whenEnabled, regrouped.whenEnabled);
+        EXPECT_EQ(grouped.whenDisabled, regrouped.whenDisabled);
+    }
+
+    static void TestStreamingSum() {
+        const std::vector<std::string> fragments{
+            "mul(", "mul(123,456)", "mul(1,2)", "mul(99,", "do()", "don't()", "do(", "don'", "m", "d", ")", "x", "7"
+        };
+        std::mt19937_64 rng{13};
+        std::uniform_int_distribution<size_t> pick{0, fragments.size() - 1};
+        for (int round = 0; round < 40; ++round) {
+            std::string memory;
+            for (int i = 0; i < 200; ++i) {
+                memory += fragments[pick(rng)];
+            }
+
+            // Any prefix gives the sums of the instructions it completes
+            Day03::StreamingSum<int64_t> byteWise;
+            for (size_t i = 0; i < memory.size(); ++i) {
+                byteWise.feed(std::string_view{memory}.substr(i, 1));
+                if (i % 37 == 0) {
+                    const std::string_view prefix = std::string_view{memory}.substr(0, i + 1);
+                    ASSERT_EQ(byteWise.sum(), Day03::processMultiplications<int64_t>(prefix)) << prefix;
+                    ASSERT_EQ(byteWise.enabledSum(), Day03::sumMultiplicationsDD<int64_t>(prefix)) << prefix;
+                }
+            }
+            EXPECT_EQ(byteWise.sum(), Day03::processMultiplications<int64_t>(memory));
+            EXPECT_EQ(byteWise.enabledSum(), Day03::sumMultiplicationsDD<int64_t>(memory));
+
+            Day03::StreamingSum<int64_t> chunked;
+            std::uniform_int_distribution<size_t> chunk{1, 100};
+            for (size_t i = 0; i < memory.size();) {
+                const size_t length = chunk(rng);
+                chunked.feed(std::string_view{memory}.substr(i, length));
+                i += length;
+            }
+            EXPECT_EQ(chunked.sum(), byteWise.sum());
+            EXPECT_EQ(chunked.enabledSum(), byteWise.enabledSum());
+        }
+    }
+
+    static void TestStreamFile() {
+        const auto path = createTempFile("mul(2,3)don't()\nmul(4,5)do()mul(1,1)");
+        const auto result = Day03::streamFile<int64_t>(path);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->sum(), 27);
+        EXPECT_EQ(result->enabledSum(), 7);
+        EXPECT_FALSE(Day03::streamFile<int64_t>("nonexistent.txt").has_value());
+    }
+
+    static void TestTokenStream() {
+        const std::string_view memory = "xmul(2,4)&mul[3,7]!^don't()_mul(5,5)+mul(32,64](mul(11,8)undo()?mul(8,5))";
+        const auto tokens = Day03::tokenize(memory);
+        ASSERT_EQ(tokens.size(), 6);
+        EXPECT_EQ(tokens.opcodes[2], Day03::Opcode::Mul);
+        EXPECT_EQ(tokens.offsets[1], 20);
+        EXPECT_EQ(tokens.lhs[1], 0); // don't() has no operands
+        EXPECT_EQ(Day03::sumAll<int64_t>(tokens), 161);
+        EXPECT_EQ(Day03::sumEnabled<int64_t>(tokens), 48);
+
+        const std::vector<Day03::Section> expected{{true, 0, 1}, {false, 20, 2}, {true, 59, 1}};
+        EXPECT_EQ(Day03::sections(tokens), expected);
+
+        // Repeated toggles do not start new sections
+        EXPECT_EQ(Day03::sections(Day03::tokenize("do()mul(1,1)do()don't()don't()")).size(), 2);
+        EXPECT_EQ(Day03::sections(Day03::tokenize("")).size(), 1);
+
+        const std::vector<std::string> fragments{"mul(12,34)", "do()", "don't()", "mul(1,", "x", "d"};
+        std::mt19937_64 rng{19};
+        std::uniform_int_distribution<size_t> pick{0, fragments.size() - 1};
+        std::string random;
+        for (int i = 0; i < 5000; ++i) {
+            random += fragments[pick(rng)];
+        }
+        const auto randomTokens = Day03::tokenize(random);
+        EXPECT_EQ(Day03::sumAll<int64_t>(randomTokens), Day03::processMultiplications<int64_t>(random));
+        EXPECT_EQ(Day03::sumEnabled<int64_t>(randomTokens), Day03::sumMultiplicationsDD<int64_t>(random));
+    }
+
     static void TestOverlappingSections() {
         const std::string input = "do()mul(2,3)don't()do()mul(4,5)don't()";
         const auto result = Day03::sumMultiplicationsDD<int64_t>(input);
@@ -124,4 +300,36 @@ TEST_F(Day03Test, LargeNumbers) {
 
 TEST_F(Day03Test, OverlappingSections) {
     TestOverlappingSections();
+}
+
+TEST_F(Day03Test, ScannerEdgeCases) {
+    TestScannerEdgeCases();
+}
+
+TEST_F(Day03Test, ScannerMatchesRegex) {
+    TestScannerMatchesRegex();
+}
+
+TEST_F(Day03Test, CandidateMask) {
+    TestCandidateMask();
+}
+
+TEST_F(Day03Test, ScanParallel) {
+    TestScanParallel();
+}
+
+TEST_F(Day03Test, CombineChunks) {
+    TestCombineChunks();
+}
+
+TEST_F(Day03Test, StreamingSum) {
+    TestStreamingSum();
+}
+
+TEST_F(Day03Test, StreamFile) {
+    TestStreamFile();
+}
+
+TEST_F(Day03Test, TokenStream) {
+    TestTokenStream();
 }
\ No newline at end of file
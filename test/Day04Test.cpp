@@ -1,3 +1,6 @@
+#include <random>
+#include <set>
+
 #include <gtest/gtest.h>
 
 #include "Day04.h"
@@ -191,6 +194,182 @@ protected:
         }
     }
 
+    static std::vector<char> randomGrid(const size_t rows, const size_t cols, const uint64_t seed) {
+        std::mt19937_64 rng{seed};
+        std::uniform_int_distribution<size_t> letter{0, 4};
+        std::vector<char> data(rows * cols);
+        std::ranges::generate(data, [&] { return "XMAS."[letter(rng)]; });
+        return data;
+    }
+
+    static size_t countWordsScalar(const std::vector<char> &data, const size_t rows, const size_t cols) {
+        std::vector<size_t> startPositions;
+        for (size_t i = 0; i < data.size(); ++i) {
+            if (data[i] == 'X') startPositions.push_back(i);
+        }
+        return Day04::findAll(data, startPositions, rows, cols).size();
+    }
+
+    static size_t countCrossesScalar(const std::vector<char> &data, const size_t rows, const size_t cols) {
+        std::vector<size_t> centers;
+        for (size_t i = 0; i < data.size(); ++i) {
+            if (data[i] == 'A') centers.push_back(i);
+        }
+        return Day04::countPatterns(data, rows, cols, centers);
+    }
+
+    static void TestBitboardMatchesScalar() {
+        // Widths around the 64 bit word size so matches cross word boundaries
+        for (const auto &[rows, cols]: std::to_array<std::pair<size_t, size_t> >(
+                 {{1, 4}, {4, 1}, {3, 3}, {9, 63}, {7, 64}, {12, 65}, {30, 130}, {140, 140}})) {
+            const auto data = randomGrid(rows, cols, rows * 1000 + cols);
+            const auto grid = Day04::toBitGrid(data, rows, cols);
+            EXPECT_EQ(Day04::countWordsBitboard(grid), countWordsScalar(data, rows, cols)) << rows << "x" << cols;
+            EXPECT_EQ(Day04::countCrossesBitboard(grid), countCrossesScalar(data, rows, cols)) << rows << "x" << cols;
+        }
+    }
+
+    static void TestPaddedGrid() {
+        const std::vector<char> data{'X', 'M', 'A', 'S', 'S', 'A', 'M', 'X'};
+        const auto grid = Day04::toPaddedGrid(data, 2, 4);
+        constexpr auto BORDER = Day04::PaddedGrid::BORDER;
+
+        EXPECT_EQ(grid.stride % Day04::PaddedGrid::ROW_ALIGNMENT, 0);
+        EXPECT_GE(grid.stride, 4 + 2 * BORDER);
+        EXPECT_EQ(grid.cells.size(), (2 + 2 * BORDER) * grid.stride);
+        for (size_t row = 0; row < 2; ++row) {
+            for (size_t col = 0; col < 4; ++col) {
+                EXPECT_EQ(grid.cells[grid.index(row, col)], data[row * 4 + col]);
+            }
+        }
+        // Every step of up to BORDER cells from a grid cell stays in the buffer and leaves the grid on sentinels
+        const auto letters = std::ranges::count_if(grid.cells, [](const char c) {
+            return c != Day04::PaddedGrid::SENTINEL;
+        });
+        EXPECT_EQ(letters, 8);
+        EXPECT_EQ(grid.cells[grid.index(0, 0) - BORDER * grid.stride - BORDER], Day04::PaddedGrid::SENTINEL);
+        EXPECT_EQ(grid.cells[grid.index(1, 3) + BORDER * grid.stride + BORDER], Day04::PaddedGrid::SENTINEL);
+    }
+
+    // Every (row, col, dir) where word starts, straight from the directions table
+    static std::vector<std::tuple<size_t, size_t, size_t> > findWordNaive(const std::vector<char> &data,
+                                                                         const size_t rows, const size_t cols,
+                                                                         const std::string_view word) {
+        std::vector<std::tuple<size_t, size_t, size_t> > found;
+        for (size_t row = 0; row < rows; ++row) {
+            for (size_t col = 0; col < cols; ++col) {
+                for (size_t dir = 0; dir < Day04::directions.size(); ++dir) {
+                    const auto [dx, dy] = Day04::decodeDirection(Day04::directions[dir]);
+                    bool matched = true;
+                    for (size_t k = 0; k < word.size() && matched; ++k) {
+                        const auto i = static_cast<std::ptrdiff_t>(row) + dx * static_cast<std::ptrdiff_t>(k);
+                        const auto j = static_cast<std::ptrdiff_t>(col) + dy * static_cast<std::ptrdiff_t>(k);
+                        matched = i >= 0 && i < static_cast<std::ptrdiff_t>(rows) && j >= 0 &&
+                                  j < static_cast<std::ptrdiff_t>(cols) &&
+                                  data[static_cast<size_t>(i) * cols + static_cast<size_t>(j)] == word[k];
+                    }
+                    if (matched) found.emplace_back(row, col, dir);
+                }
+            }
+        }
+        return found;
+    }
+
+    static void TestCountAndPackedMatchFindAll() {
+        for (const auto &[rows, cols]: std::to_array<std::pair<size_t, size_t> >({{1, 4}, {4, 1}, {9, 13}, {200, 150}})) {
+            const auto data = randomGrid(rows, cols, rows * 17 + cols);
+            std::vector<size_t> startPositions;
+            for (size_t i = 0; i < data.size(); ++i) {
+                if (data[i] == 'X') startPositions.push_back(i);
+            }
+            const auto expected = Day04::findAll(data, startPositions, rows, cols);
+            const auto grid = Day04::toPaddedGrid(data, rows, cols);
+            EXPECT_EQ(Day04::countAll(grid, startPositions), expected.size());
+
+            const auto packed = Day04::findAllPacked(grid, startPositions);
+            ASSERT_TRUE(packed.has_value());
+            std::vector<std::tuple<size_t, size_t, size_t> > unpacked;
+            for (const auto match: *packed) {
+                unpacked.push_back(Day04::unpackMatch(match, cols));
+            }
+            EXPECT_EQ(unpacked, expected) << rows << "x" << cols;
+        }
+
+        // 2^29 cells still fit in 32 bits with the direction, one more row does not
+        const Day04::PaddedGrid huge{(1 << 19) + 1, 1 << 10, 0, {}};
+        EXPECT_FALSE(Day04::findAllPacked(huge, {}).has_value());
+    }
+
+    static void TestTiledMatchesScalar() {
+        for (const auto &[rows, cols]: std::to_array<std::pair<size_t, size_t> >({{1, 4}, {4, 1}, {9, 13}, {300, 77}})) {
+            const auto data = randomGrid(rows, cols, rows * 7 + cols);
+            const auto grid = Day04::toPaddedGrid(data, rows, cols);
+            const auto words = countWordsScalar(data, rows, cols);
+            const auto crosses = countCrossesScalar(data, rows, cols);
+            // Tiles thinner or narrower than the halo and ones that do not divide the grid evenly
+            for (const size_t band: {0, 1, 2, 3, 7, 64}) {
+                for (const size_t width: {0, 1, 3, 5, 64}) {
+                    EXPECT_EQ(Day04::countWordsTiled(grid, band, width), words)
+                        << rows << "x" << cols << " tile " << band << "x" << width;
+                    EXPECT_EQ(Day04::countCrossesTiled(grid, band, width), crosses)
+                        << rows << "x" << cols << " tile " << band << "x" << width;
+                }
+            }
+        }
+    }
+
+    static void TestTileShape() {
+        // Short rows: whole-row tiles, as tall as L2_BYTES allows with the halo
+        const auto small = Day04::toPaddedGrid(std::vector<char>(100 * 100, 'X'), 100, 100);
+        const auto whole = Day04::tileShape(small, 0, 0);
+        EXPECT_EQ(whole.cols, 100);
+        EXPECT_EQ(whole.rows, Day04::L2_BYTES / small.stride - 2 * Day04::PaddedGrid::BORDER);
+
+        // Rows so long that the window around one row overflows L2_BYTES: narrower tiles that still fit
+        const Day04::PaddedGrid wide{4, 1 << 20, (1 << 20) + 64, {}};
+        const auto tile = Day04::tileShape(wide, 0, 0);
+        EXPECT_LT(tile.cols, wide.cols);
+        EXPECT_EQ(tile.cols % Day04::PaddedGrid::ROW_ALIGNMENT, 0);
+        EXPECT_GE(tile.rows, Day04::TILE_MIN_ROWS);
+        EXPECT_LE((tile.rows + 2 * Day04::PaddedGrid::BORDER) * (tile.cols + 2 * Day04::PaddedGrid::BORDER),
+                  Day04::L2_BYTES);
+
+        // Explicit sizes win, clamped to the grid
+        EXPECT_EQ(Day04::tileShape(small, 5, 1000).rows, 5);
+        EXPECT_EQ(Day04::tileShape(small, 5, 1000).cols, 100);
+    }
+
+    static void TestFindWordsMatchesFindAll() {
+        for (const auto &[rows, cols]: std::to_array<std::pair<size_t, size_t> >({{1, 4}, {4, 1}, {9, 13}, {40, 70}})) {
+            const auto data = randomGrid(rows, cols, rows * 31 + cols);
+            std::vector<size_t> startPositions;
+            for (size_t i = 0; i < data.size(); ++i) {
+                if (data[i] == 'X') startPositions.push_back(i);
+            }
+            const auto words = Day04::findWords(data, rows, cols, std::array{Day04::target});
+            ASSERT_TRUE(words.has_value());
+            ASSERT_EQ(words->size(), 1);
+            EXPECT_EQ(words->front(), Day04::findAll(data, startPositions, rows, cols)) << rows << "x" << cols;
+        }
+    }
+
+    static void TestFindWordsDictionary() {
+        // Prefixes, suffixes, a palindrome and a duplicate share one automaton
+        constexpr auto words = std::to_array<std::string_view>({"XMAS", "MAS", "AS", "SAMAS", "AMA", "M", "MAS"});
+        constexpr size_t rows = 23;
+        constexpr size_t cols = 37;
+        const auto data = randomGrid(rows, cols, 99);
+        const auto found = Day04::findWords(data, rows, cols, words);
+        ASSERT_TRUE(found.has_value());
+        ASSERT_EQ(found->size(), words.size());
+        for (size_t i = 0; i < words.size(); ++i) {
+            EXPECT_EQ((*found)[i], findWordNaive(data, rows, cols, words[i])) << words[i];
+        }
+
+        constexpr auto invalid = std::to_array<std::string_view>({"XMAS", ""});
+        EXPECT_FALSE(Day04::findWords(data, rows, cols, invalid).has_value());
+    }
+
     static void TestEdgeCases() {
         // Test pattern at edge of grid
         const std::string input = "XMAS\nXMAS";
@@ -246,4 +425,32 @@ TEST_F(Day04Test, AllDirections) {
 
 TEST_F(Day04Test, EdgeCases) {
     TestEdgeCases();
+}
+
+TEST_F(Day04Test, PaddedGrid) {
+    TestPaddedGrid();
+}
+
+TEST_F(Day04Test, CountAndPackedMatchFindAll) {
+    TestCountAndPackedMatchFindAll();
+}
+
+TEST_F(Day04Test, TiledMatchesScalar) {
+    TestTiledMatchesScalar();
+}
+
+TEST_F(Day04Test, TileShape) {
+    TestTileShape();
+}
+
+TEST_F(Day04Test, FindWordsMatchesFindAll) {
+    TestFindWordsMatchesFindAll();
+}
+
+TEST_F(Day04Test, FindWordsDictionary) {
+    TestFindWordsDictionary();
+}
+
+TEST_F(Day04Test, BitboardMatchesScalar) {
+    TestBitboardMatchesScalar();
 }
\ No newline at end of file
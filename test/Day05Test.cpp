@@ -61,6 +61,17 @@ protected:
         ASSERT_FALSE(ruleMapInvalid.has_value());
     }
 
+    static void TestReadRules() {
+        const auto path = createTempFile("47|53\r\n\n97|13\n");
+        const auto rules = Day05::readRules<int>(path);
+        ASSERT_TRUE(rules.has_value());
+        EXPECT_EQ(*rules, (std::vector<std::pair<int, int> >{{47, 53}, {97, 13}}));
+
+        for (const std::string content: {"47|", "|53", "47,53", "47|53|1", "47 |53", "99999999999|1"}) {
+            EXPECT_FALSE(Day05::readRules<int>(createTempFile(content)).has_value()) << content;
+        }
+    }
+
     static void TestBreaksRule() {
         const std::unordered_set rules{2, 4, 6};
 
@@ -157,6 +168,10 @@ TEST_F(Day05Test, BuildRuleMap) {
     TestBuildRuleMap();
 }
 
+TEST_F(Day05Test, ReadRules) {
+    TestReadRules();
+}
+
 TEST_F(Day05Test, BreaksRule) {
     TestBreaksRule();
 }
@@ -0,0 +1,49 @@
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "Pattern.h"
+
+class PatternTest : public ::testing::Test {
+protected:
+    using Mul = aoc::pattern::Matcher<R"(mul(\d{1,3},\d{1,3}))">;
+    using Rule = aoc::pattern::Matcher<R"(\d+|\d+)">;
+
+    // Everything is known at compile time, so the matcher works in constant expressions too
+    static_assert(Mul::CAPTURES == 2 && Mul::MAX_LENGTH == 12);
+    static_assert(Rule::MAX_LENGTH == aoc::pattern::detail::UNBOUNDED);
+    static_assert(aoc::pattern::Matcher<R"(do())">::CAPTURES == 0);
+    static_assert(aoc::pattern::Matcher<R"(a\\b\d)">::ELEMENTS.size() == 4);
+    static_assert(aoc::pattern::match<R"(\d+|\d+)", int>("47|53") == std::array{47, 53});
+
+    static void TestMatchPrefix() {
+        std::array<uint16_t, 2> operands{};
+        EXPECT_EQ(Mul::matchPrefix(std::string_view{"mul(12,345)tail"}, operands), 11);
+        EXPECT_EQ(operands, (std::array<uint16_t, 2>{12, 345}));
+        for (const std::string_view miss: {"mul(1234,5)", "mul(,5)", "mul(1,2", "mul(1 ,2)", "mu(1,2)", ""}) {
+            EXPECT_EQ(Mul::matchPrefix(miss, operands), 0) << miss;
+        }
+        EXPECT_EQ(aoc::pattern::Matcher<R"(don't())">::matchPrefix("don't()do()"), 7);
+    }
+
+    static void TestWholeMatch() {
+        EXPECT_EQ((Rule::match<int64_t>("123456789012|7")), (std::array<int64_t, 2>{123456789012, 7}));
+        EXPECT_FALSE(Rule::match<int>("1|2 ").has_value());
+        EXPECT_FALSE(Rule::match<int>("").has_value());
+        EXPECT_FALSE(Rule::match<int>("1|").has_value());
+        // Too large for the capture type
+        EXPECT_FALSE(Rule::match<int8_t>("128|1").has_value());
+        EXPECT_EQ((Rule::match<int8_t>("127|1")), (std::array<int8_t, 2>{127, 1}));
+        EXPECT_EQ((aoc::pattern::match<R"(\d{3}-x)", double>("042-x")), (std::array{42.0}));
+    }
+};
+
+TEST_F(PatternTest, MatchPrefix) {
+    TestMatchPrefix();
+}
+
+TEST_F(PatternTest, WholeMatch) {
+    TestWholeMatch();
+}
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "RadixSort.h"
+
+class RadixSortTest : public ::testing::Test {
+protected:
+    template<typename T>
+    static std::vector<T> randomValues(const size_t size, const T low, const T high) {
+        std::mt19937_64 rng{42};
+        std::vector<T> values(size);
+        if constexpr (std::is_floating_point_v<T>) {
+            std::uniform_real_distribution<T> dist{low, high};
+            std::ranges::generate(values, [&] { return dist(rng); });
+        } else {
+            std::uniform_int_distribution<T> dist{low, high};
+            std::ranges::generate(values, [&] { return dist(rng); });
+        }
+        return values;
+    }
+
+    template<typename T>
+    static void ExpectSortedLikeStd(std::vector<T> values) {
+        auto expected = values;
+        std::ranges::sort(expected);
+
+        auto sequential = values;
+        aoc::sort::radixSort<T>(sequential);
+        EXPECT_EQ(sequential, expected);
+
+        aoc::sort::parallelRadixSort<T>(values);
+        EXPECT_EQ(values, expected);
+    }
+
+    static void TestSignedIntegers() {
+        ExpectSortedLikeStd<int64_t>({5, -3, 0, std::numeric_limits<int64_t>::min(), 42, -3,
+                                      std::numeric_limits<int64_t>::max(), -1});
+        ExpectSortedLikeStd(randomValues<int32_t>(1 << 18, -1'000'000, 1'000'000));
+        ExpectSortedLikeStd(randomValues<int64_t>(1 << 18, std::numeric_limits<int64_t>::min(),
+                                                  std::numeric_limits<int64_t>::max()));
+    }
+
+    static void TestUnsignedIntegers() {
+        ExpectSortedLikeStd<uint8_t>({200, 1, 0, 255, 7, 7});
+        ExpectSortedLikeStd(randomValues<uint64_t>(1 << 18, 0, std::numeric_limits<uint64_t>::max()));
+    }
+
+    static void TestFloatingPoint() {
+        ExpectSortedLikeStd<double>({1.5, -0.25, 3.0, -100.0, 0.0, 2.75, -2.75});
+        ExpectSortedLikeStd(randomValues<float>(1 << 18, -1e6f, 1e6f));
+    }
+
+    static void TestPuzzleShapedInput() {
+        // Five digit IDs share their upper bytes, so most passes are skipped
+        ExpectSortedLikeStd(randomValues<int64_t>(1 << 20, 10000, 99999));
+    }
+
+    static void TestTrivialInputs() {
+        ExpectSortedLikeStd<int64_t>({});
+        ExpectSortedLikeStd<int64_t>({7});
+        ExpectSortedLikeStd<int64_t>({3, 3, 3, 3});
+    }
+};
+
+TEST_F(RadixSortTest, SignedIntegers) {
+    TestSignedIntegers();
+}
+
+TEST_F(RadixSortTest, UnsignedIntegers) {
+    TestUnsignedIntegers();
+}
+
+TEST_F(RadixSortTest, FloatingPoint) {
+    TestFloatingPoint();
+}
+
+TEST_F(RadixSortTest, PuzzleShapedInput) {
+    TestPuzzleShapedInput();
+}
+
+TEST_F(RadixSortTest, TrivialInputs) {
+    TestTrivialInputs();
+}
@@ -0,0 +1,68 @@
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Simd.h"
+
+class SimdTest : public ::testing::Test {
+protected:
+    template<typename T>
+    static std::vector<T> randomValues(const size_t size, const uint64_t seed) {
+        std::mt19937_64 rng{seed};
+        std::uniform_int_distribution<T> dist{-100000, 100000};
+        std::vector<T> values(size);
+        std::ranges::generate(values, [&] { return dist(rng); });
+        return values;
+    }
+
+    template<typename T>
+    static void ExpectKernelsMatchScalar(const size_t size) {
+        const auto a = randomValues<T>(size, 1);
+        const auto b = randomValues<T>(size, 2);
+
+        T absDiff{0};
+        T products{0};
+        for (size_t i = 0; i < size; ++i) {
+            absDiff += a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+            products += a[i] * b[i];
+        }
+
+        EXPECT_EQ(aoc::simd::sumAbsDiff<T>(a, b), absDiff) << "size " << size;
+        EXPECT_EQ(aoc::simd::sumProducts<T>(a, b), products) << "size " << size;
+        EXPECT_EQ(aoc::simd::parallelSumAbsDiff<T>(a, b), absDiff) << "size " << size;
+        EXPECT_EQ(aoc::simd::parallelSumProducts<T>(a, b), products) << "size " << size;
+    }
+
+    static void TestInt64Kernels() {
+        // Sizes around every vector width so both the main loop and the tail are exercised
+        for (const size_t size: {0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 1000, 300001}) {
+            ExpectKernelsMatchScalar<int64_t>(size);
+        }
+    }
+
+    static void TestInt32Kernels() {
+        for (const size_t size: {0, 1, 7, 8, 15, 16, 31, 32, 33, 1000, 300001}) {
+            ExpectKernelsMatchScalar<int32_t>(size);
+        }
+    }
+
+    static void TestNegativeProducts() {
+        const std::vector<int64_t> a{-3, 4, -5, 6, -7, 8, -9, 10, -11};
+        const std::vector<int64_t> b{2, -2, 2, -2, 2, -2, 2, -2, 2};
+        EXPECT_EQ(aoc::simd::sumProducts<int64_t>(a, b), -126);
+        EXPECT_EQ(aoc::simd::sumAbsDiff<int64_t>(a, b), 81);
+    }
+};
+
+TEST_F(SimdTest, Int64Kernels) {
+    TestInt64Kernels();
+}
+
+TEST_F(SimdTest, Int32Kernels) {
+    TestInt32Kernels();
+}
+
+TEST_F(SimdTest, NegativeProducts) {
+    TestNegativeProducts();
+}